@@ -1464,6 +1464,149 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FU
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void *pvItems,
+ *                                  UBaseType_t uxCount,
+ *                                  TickType_t xTicksToWait
+ *                                );
+ * @endcode
+ *
+ * Post up to uxCount items, stored one after the other at pvItems, to the
+ * back of a queue.  All the items that fit are copied within one critical
+ * section and at most one task waiting to receive is unblocked per item, so
+ * a burst costs one kernel entry instead of one per item.
+ *
+ * configUSE_QUEUE_MULTIPLE must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It cannot be used on semaphores, mutexes or
+ * queues that are members of a queue set.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxCount items of the size the queue was
+ * created with.
+ *
+ * @param uxCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space while not all items have been posted.  When it expires
+ * whatever fits at that moment is posted.
+ *
+ * @return The number of items posted, from the start of pvItems.  Less than
+ * uxCount only if the block time expired.
+ *
+ * Example usage:
+ * @code{c}
+ * uint32_t ulSamples[ 8 ];
+ *
+ * // Post a burst of 8 samples, waiting up to 10 ticks for room.
+ * if( uxQueueSendMultiple( xQueue, ulSamples, 8, 10 ) != 8 )
+ * {
+ *     // Only part of the burst was posted.
+ * }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+    UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                     const void * const pvItems,
+                                     UBaseType_t uxCount,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void *pvBuffer,
+ *                                     UBaseType_t uxMaxCount,
+ *                                     UBaseType_t uxMinCount,
+ *                                     TickType_t xTicksToWait
+ *                                   );
+ * @endcode
+ *
+ * Receive up to uxMaxCount items from a queue, blocking until at least
+ * uxMinCount items have been received or the block time expires.  Items are
+ * copied out in as few critical sections as they arrived in, and at most one
+ * task waiting to send is unblocked per item removed.
+ *
+ * configUSE_QUEUE_MULTIPLE must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxCount items.  Items
+ * are stored one after the other, oldest first.
+ *
+ * @param uxMaxCount The most items to receive.
+ *
+ * @param uxMinCount The number of items to wait for, 1 to uxMaxCount.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * while fewer than uxMinCount items have been received.
+ *
+ * @return The number of items received.  Less than uxMinCount only if the
+ * block time expired, 0 if nothing arrived.
+ *
+ * Example usage:
+ * @code{c}
+ * uint32_t ulSamples[ 16 ];
+ * UBaseType_t uxReceived;
+ *
+ * // Process samples in groups of at least 4, or what came within 100 ticks.
+ * uxReceived = uxQueueReceiveMultiple( xQueue, ulSamples, 16, 4, 100 );
+ * @endcode
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+    UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        UBaseType_t uxMaxCount,
+                                        UBaseType_t uxMinCount,
+                                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                         QueueHandle_t xQueue,
+ *                                         const void *pvItems,
+ *                                         UBaseType_t uxCount,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken
+ *                                       );
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                            QueueHandle_t xQueue,
+ *                                            void *pvBuffer,
+ *                                            UBaseType_t uxMaxCount,
+ *                                            BaseType_t *pxHigherPriorityTaskWoken
+ *                                          );
+ * @endcode
+ *
+ * Versions of uxQueueSendMultiple() and uxQueueReceiveMultiple() that can be
+ * used in an interrupt service routine.  They move as many items as fit (or
+ * are available) right now and return that number, which may be 0.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if moving the items
+ * unblocked a task with a priority higher than the running task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ */
+    UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItems,
+                                            UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               UBaseType_t uxMaxCount,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+
 #if ( configUSE_CO_ROUTINES == 1 )
 
 /*
@@ -1502,6 +1645,20 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                            StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Use xSemaphoreCreateMutexWithCeiling() or
+ * xSemaphoreCreateMutexWithCeilingStatic() instead of calling these functions
+ * directly.
+ */
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                          StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+    #endif
+#endif
+
 #if ( configUSE_COUNTING_SEMAPHORES == 1 )
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
@@ -82,6 +82,14 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+/* A priority ceiling mutex raises its holder when it is taken, so a task that
+ * blocks on it never changes the priority of the holder. */
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    #define queueMUTEX_USES_INHERITANCE( pxQueue )    ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) && ( ( pxQueue )->uxCeilingPriority == ( UBaseType_t ) 0U ) )
+#else
+    #define queueMUTEX_USES_INHERITANCE( pxQueue )    ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -133,6 +141,10 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority; /**< The priority a task taking the mutex is raised to, or 0 if the mutex uses priority inheritance. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -210,6 +222,28 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+/*
+ * Copy uxCount items into or out of a queue that has room for, or holds,
+ * at least that many items.  At most two memcpy() calls, one either side of
+ * the wrap point of the storage area.
+ */
+    static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                        const uint8_t * pucItems,
+                                        UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+    static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                          uint8_t * pucBuffer,
+                                          UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxCount tasks from pxEventList, highest priority first.
+ * Returns pdTRUE if any of them has a priority above the running task.
+ */
+    static BaseType_t prvRemoveMultipleFromEventList( List_t * const pxEventList,
+                                                      UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -602,6 +636,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_TRACE_FACILITY */
 
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    {
+        pxNewQueue->uxCeilingPriority = ( UBaseType_t ) 0U;
+    }
+    #endif /* configUSE_MUTEX_PRIORITY_CEILING */
+
     #if ( configUSE_QUEUE_SETS == 1 )
     {
         pxNewQueue->pxQueueSetContainer = NULL;
@@ -687,6 +727,57 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( ( uxCeilingPriority > ( UBaseType_t ) 0U ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( ( uxCeilingPriority > ( UBaseType_t ) 0U ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -1704,6 +1795,19 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+                        {
+                            if( pxQueue->uxCeilingPriority != ( UBaseType_t ) 0U )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_MUTEX_PRIORITY_CEILING */
                     }
                     else
                     {
@@ -1784,7 +1888,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    if( queueMUTEX_USES_INHERITANCE( pxQueue ) )
                     {
                         taskENTER_CRITICAL();
                         {
@@ -2135,6 +2239,430 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                     const void * const pvItems,
+                                     UBaseType_t uxCount,
+                                     TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        const uint8_t * const pucItems = ( const uint8_t * ) pvItems;
+        UBaseType_t uxSent = ( UBaseType_t ) 0;
+        UBaseType_t uxMove;
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItems == NULL ) && ( uxCount != ( UBaseType_t ) 0U ) ) );
+
+        /* Semaphores and mutexes have no items to move in bulk. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* A queue set is notified once per item, which is what the batch
+         * avoids, so members of a set use the single item API. */
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Move as many of the remaining items as there is space for,
+                 * then unblock at most one receiving task per item moved. */
+                uxMove = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+                if( uxMove > ( uxCount - uxSent ) )
+                {
+                    uxMove = uxCount - uxSent;
+                }
+
+                if( uxMove > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_SEND( pxQueue );
+                    prvCopyMultipleToQueue( pxQueue, &( pucItems[ uxSent * pxQueue->uxItemSize ] ), uxMove );
+                    uxSent += uxMove;
+
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToReceive ), uxMove ) != pdFALSE )
+                    {
+                        /* The yield is held pending until the critical
+                         * section is exited. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( uxSent == uxCount ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+                {
+                    /* Everything was sent, or the queue is full and no (more)
+                     * block time is left. */
+                    taskEXIT_CRITICAL();
+
+                    if( uxSent < uxCount )
+                    {
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    return uxSent;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Space became available, loop back and fill it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back once with no block time to move
+                 * whatever fits now and return the total. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        UBaseType_t uxMaxCount,
+                                        UBaseType_t uxMinCount,
+                                        TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        uint8_t * const pucBuffer = ( uint8_t * ) pvBuffer;
+        UBaseType_t uxReceived = ( UBaseType_t ) 0;
+        UBaseType_t uxMove;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer != NULL );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( ( uxMinCount > ( UBaseType_t ) 0U ) && ( uxMinCount <= uxMaxCount ) );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Take everything available up to uxMaxCount, then unblock
+                 * at most one sending task per item removed. */
+                uxMove = pxQueue->uxMessagesWaiting;
+
+                if( uxMove > ( uxMaxCount - uxReceived ) )
+                {
+                    uxMove = uxMaxCount - uxReceived;
+                }
+
+                if( uxMove > ( UBaseType_t ) 0 )
+                {
+                    prvCopyMultipleFromQueue( pxQueue, &( pucBuffer[ uxReceived * pxQueue->uxItemSize ] ), uxMove );
+                    traceQUEUE_RECEIVE( pxQueue );
+                    uxReceived += uxMove;
+
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToSend ), uxMove ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( uxReceived >= uxMinCount ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+                {
+                    /* Enough items arrived, or no (more) block time is left,
+                     * in which case the caller gets what there was. */
+                    taskEXIT_CRITICAL();
+
+                    if( uxReceived == ( UBaseType_t ) 0 )
+                    {
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    return uxReceived;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* The items taken so far stay in pvBuffer, the task waits
+                 * for the queue to get more. */
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back once with no block time to collect
+                 * whatever is there now and return the total. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItems,
+                                            UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxMove;
+        UBaseType_t uxItem;
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItems == NULL ) && ( uxCount != ( UBaseType_t ) 0U ) ) );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+        #endif
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            uxMove = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+            if( uxMove > uxCount )
+            {
+                uxMove = uxCount;
+            }
+
+            if( uxMove > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+                prvCopyMultipleToQueue( pxQueue, ( const uint8_t * ) pvItems, uxMove );
+
+                if( pxQueue->cTxLock == queueUNLOCKED )
+                {
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToReceive ), uxMove ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue is locked, count every item so the task that
+                     * unlocks it unblocks as many receivers as a sequence of
+                     * single item sends would have. */
+                    for( uxItem = ( UBaseType_t ) 0; uxItem < uxMove; uxItem++ )
+                    {
+                        const int8_t cTxLock = pxQueue->cTxLock;
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxMove;
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               UBaseType_t uxMaxCount,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxMove;
+        UBaseType_t uxItem;
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxCount != ( UBaseType_t ) 0U ) ) );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            uxMove = pxQueue->uxMessagesWaiting;
+
+            if( uxMove > uxMaxCount )
+            {
+                uxMove = uxMaxCount;
+            }
+
+            if( uxMove > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+                prvCopyMultipleFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxMove );
+
+                if( pxQueue->cRxLock == queueUNLOCKED )
+                {
+                    if( prvRemoveMultipleFromEventList( &( pxQueue->xTasksWaitingToSend ), uxMove ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    for( uxItem = ( UBaseType_t ) 0; uxItem < uxMove; uxItem++ )
+                    {
+                        const int8_t cRxLock = pxQueue->cRxLock;
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxMove;
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
                               void * const pvBuffer )
 {
@@ -2494,6 +3022,125 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                        const uint8_t * pucItems,
+                                        UBaseType_t uxCount )
+    {
+        /* This function is called from a critical section. */
+        const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+        if( xFirst > xBytes )
+        {
+            xFirst = xBytes;
+        }
+
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pucItems, xFirst );
+
+        if( xFirst < xBytes )
+        {
+            /* The rest goes to the start of the storage area. */
+            ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pucItems[ xFirst ] ), xBytes - xFirst );
+            pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirst );
+        }
+        else
+        {
+            pxQueue->pcWriteTo += xBytes;
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxQueue->uxMessagesWaiting += uxCount;
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                          uint8_t * pucBuffer,
+                                          UBaseType_t uxCount )
+    {
+        /* This function is called from a critical section with uxCount not
+         * zero.  pcReadFrom points to the last item read, the first item to
+         * copy follows it. */
+        const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+        int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+        size_t xFirst;
+
+        if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+        if( xFirst > xBytes )
+        {
+            xFirst = xBytes;
+        }
+
+        ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) pcReadFrom, xFirst );
+
+        if( xFirst < xBytes )
+        {
+            ( void ) memcpy( ( void * ) &( pucBuffer[ xFirst ] ), ( const void * ) pxQueue->pcHead, xBytes - xFirst );
+            pcReadFrom = pxQueue->pcHead + ( xBytes - xFirst );
+        }
+        else
+        {
+            pcReadFrom += xBytes;
+        }
+
+        /* Back to the last item read. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+        pxQueue->uxMessagesWaiting -= uxCount;
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_MULTIPLE == 1 )
+
+    static BaseType_t prvRemoveMultipleFromEventList( List_t * const pxEventList,
+                                                      UBaseType_t uxCount )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        while( ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxCount--;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_MULTIPLE */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -79,6 +79,27 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( 0x02U )
     #define tmrSTATUS_IS_AUTORELOAD              ( 0x04U )
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Slots per level of the timer wheel, and the mask of a slot index. */
+        #define tmrWHEEL_SLOTS    ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_MASK     ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+
+/* Ticks covered by all levels together.  Timers further away are parked in
+ * the top level and placed again each time their slot comes round. */
+        #define tmrWHEEL_SPAN     ( ( TickType_t ) 1U << ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) )
+
+        #if ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) >= 16 ) )
+            #error configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS must be below the width of TickType_t.
+        #elif ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) >= 32 )
+            #error configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS must be below the width of TickType_t.
+        #endif
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( ( configTIMER_COMMAND_BATCH > 1 ) && ( configUSE_QUEUE_MULTIPLE != 1 ) )
+        #error configTIMER_COMMAND_BATCH above 1 needs configUSE_QUEUE_MULTIPLE set to 1.
+    #endif
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                                               /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -134,6 +155,8 @@
         } u;
     } DaemonTaskMessage_t;
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
 /* The list in which active timers are stored.  Timers are referenced in expire
  * time order, with the nearest expiry time at the front of the list.  Only the
  * timer service task is allowed to access these lists.
@@ -145,6 +168,24 @@
     PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* The hierarchical timer wheel in which active timers are stored.  Level 0
+ * has one slot per tick, each further level one slot per full turn of the
+ * level below.  A timer sits unsorted in the slot of its expiry time in the
+ * lowest level that reaches that far, so starting, resetting or stopping it
+ * is a single list insert or remove.  When xTimerWheelTime reaches the start
+ * of a slot of a higher level the timers of that slot are moved down.  Only
+ * the timer service task is allowed to access the wheel. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+
+/* The tick up to which the wheel has been processed. */
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
@@ -188,6 +229,8 @@
                                 TickType_t xExpiredTime,
                                 const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
@@ -201,6 +244,40 @@
  */
     static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
 
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place an active timer in the wheel slot of its expiry time, relative to
+ * xTimerWheelTime.
+ */
+        static void prvWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set *pxNextEvent to the nearest tick at which a timer expires or a slot
+ * of a higher level has to be moved down.  Returns pdFALSE if the wheel is
+ * empty.
+ */
+        static BaseType_t prvWheelNextEvent( TickType_t * const pxNextEvent ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xTimerWheelTime forward to xTimeNow, event by event, calling the
+ * callbacks of the timers that expire on the way.
+ */
+        static void prvWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configTIMER_COMMAND_BATCH > 1 )
+
+/*
+ * Hand out the next command, taking up to configTIMER_COMMAND_BATCH of them
+ * from the timer queue in one go when the previous batch is used up.
+ */
+        static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+    #endif /* configTIMER_COMMAND_BATCH */
+
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
@@ -711,6 +788,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
@@ -739,6 +818,8 @@
         traceTIMER_EXPIRED( pxTimer );
         pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -775,6 +856,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
@@ -929,6 +1012,8 @@
 
         return xProcessTimerNow;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvProcessReceivedCommands( void )
@@ -938,7 +1023,11 @@
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
+        #if ( configTIMER_COMMAND_BATCH > 1 )
+        while( prvReceiveCommand( &xMessage ) != pdFAIL )
+        #else
         while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+        #endif
         {
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
             {
@@ -1086,6 +1175,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
@@ -1109,6 +1200,299 @@
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
+        {
+            TickType_t xTimeNow;
+
+            vTaskSuspendAll();
+            {
+                xTimeNow = xTaskGetTickCount();
+
+                /* Times are compared as distances from xTimerWheelTime, which
+                 * stays correct across an overflow of the tick count, so there
+                 * are no lists to switch. */
+                if( ( xListWasEmpty == pdFALSE ) &&
+                    ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+                {
+                    ( void ) xTaskResumeAll();
+                    prvWheelAdvance( xTimeNow );
+                }
+                else
+                {
+                    /* Block until the next event of the wheel or a command,
+                     * or only until a command if the wheel is empty. */
+                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+        {
+            TickType_t xNextExpireTime = ( TickType_t ) 0U;
+
+            /* The next event is not always an expiry, it can be the tick at
+             * which a slot of a higher level is moved down.  Waking for it
+             * costs one pass of prvWheelAdvance(). */
+            if( prvWheelNextEvent( &xNextExpireTime ) == pdFALSE )
+            {
+                *pxListWasEmpty = pdTRUE;
+            }
+            else
+            {
+                *pxListWasEmpty = pdFALSE;
+            }
+
+            return xNextExpireTime;
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+        {
+            TickType_t xTimeNow;
+
+            xTimeNow = xTaskGetTickCount();
+
+            /* Timers that became due before the command being processed was
+             * received expire first, as the list implementation does when it
+             * switches lists. */
+            prvWheelAdvance( xTimeNow );
+
+            *pxTimerListsWereSwitched = pdFALSE;
+
+            return xTimeNow;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
+        {
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            /* Has the expiry time elapsed between the command being issued and
+             * the command being processed?  Measured from the command time so
+             * an overflow of the tick count in between makes no difference. */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) )
+            {
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                prvWheelInsert( pxTimer );
+            }
+
+            return xProcessTimerNow;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvWheelInsert( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            const TickType_t xDelta = ( TickType_t ) ( xExpiryTime - xTimerWheelTime );
+            TickType_t xSlotTime = xExpiryTime;
+            UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+
+            /* The lowest level that reaches xExpiryTime. */
+            while( ( uxLevel < ( ( UBaseType_t ) configTIMER_WHEEL_LEVELS - ( UBaseType_t ) 1U ) ) &&
+                   ( xDelta >= ( ( TickType_t ) 1U << ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel + ( UBaseType_t ) 1U ) ) ) ) )
+            {
+                uxLevel++;
+            }
+
+            if( xDelta >= tmrWHEEL_SPAN )
+            {
+                /* Beyond the wheel.  Park the timer in the furthest slot of the
+                 * top level, it is placed again when that slot is moved down. */
+                xSlotTime = xTimerWheelTime + ( tmrWHEEL_SPAN - ( TickType_t ) 1U );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vListInsertEnd( &( xTimerWheel[ uxLevel ][ ( xSlotTime >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_MASK ] ), &( pxTimer->xTimerListItem ) );
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvWheelNextEvent( TickType_t * const pxNextEvent )
+        {
+            BaseType_t xFound = pdFALSE;
+            UBaseType_t uxLevel;
+            UBaseType_t uxStep;
+            TickType_t xIndex;
+            TickType_t xEventTime;
+
+            /* Look at most one turn ahead in every level.  The nearest
+             * non-empty slot of each level is a candidate, the nearest of those
+             * is the next event.  The cost is bounded by the size of the wheel,
+             * not by the number of timers. */
+            for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+            {
+                xIndex = xTimerWheelTime >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel );
+
+                /* The slot of the current index is reached again after a full
+                 * turn, hence the steps run up to and including tmrWHEEL_SLOTS. */
+                for( uxStep = ( UBaseType_t ) 1U; uxStep <= tmrWHEEL_SLOTS; uxStep++ )
+                {
+                    if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ ( xIndex + uxStep ) & tmrWHEEL_MASK ] ) ) == pdFALSE )
+                    {
+                        xEventTime = ( TickType_t ) ( ( xIndex + uxStep ) << ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) );
+
+                        if( ( xFound == pdFALSE ) ||
+                            ( ( TickType_t ) ( xEventTime - xTimerWheelTime ) < ( TickType_t ) ( *pxNextEvent - xTimerWheelTime ) ) )
+                        {
+                            *pxNextEvent = xEventTime;
+                            xFound = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+
+            return xFound;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvWheelAdvance( const TickType_t xTimeNow )
+        {
+            TickType_t xNextEvent;
+            UBaseType_t uxLevel;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            while( xTimerWheelTime != xTimeNow )
+            {
+                /* Jump straight to the next event, or to xTimeNow if nothing
+                 * happens before it. */
+                if( ( prvWheelNextEvent( &xNextEvent ) == pdFALSE ) ||
+                    ( ( TickType_t ) ( xNextEvent - xTimerWheelTime ) > ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+                {
+                    xTimerWheelTime = xTimeNow;
+                    break;
+                }
+
+                xTimerWheelTime = xNextEvent;
+
+                /* Move the timers of every higher level slot that starts at
+                 * this tick down, lowest level first. */
+                for( uxLevel = ( UBaseType_t ) 1U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    if( ( xTimerWheelTime & ( ( ( TickType_t ) 1U << ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+                    {
+                        break;
+                    }
+
+                    pxSlot = &( xTimerWheel[ uxLevel ][ ( xTimerWheelTime >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_MASK ] );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvWheelInsert( pxTimer );
+                    }
+                }
+
+                /* Every timer now in the level 0 slot of this tick expires. */
+                pxSlot = &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_MASK ] );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                    /* A reloaded timer goes at least one tick ahead, never back
+                     * into this slot. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                    {
+                        prvReloadTimer( pxTimer, xTimerWheelTime, xTimeNow );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+
+                    traceTIMER_EXPIRED( pxTimer );
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configTIMER_COMMAND_BATCH > 1 )
+
+        static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage )
+        {
+            PRIVILEGED_DATA static DaemonTaskMessage_t xBatch[ configTIMER_COMMAND_BATCH ];
+            PRIVILEGED_DATA static UBaseType_t uxBatchCount = ( UBaseType_t ) 0U;
+            PRIVILEGED_DATA static UBaseType_t uxBatchNext = ( UBaseType_t ) 0U;
+
+            if( uxBatchNext == uxBatchCount )
+            {
+                /* One critical section for the whole batch.  The batch is
+                 * used up before prvProcessReceivedCommands() returns, as it
+                 * only returns once this function found the queue empty. */
+                uxBatchCount = uxQueueReceiveMultiple( xTimerQueue, xBatch, ( UBaseType_t ) configTIMER_COMMAND_BATCH, ( UBaseType_t ) 1U, tmrNO_DELAY );
+                uxBatchNext = ( UBaseType_t ) 0U;
+
+                if( uxBatchCount == ( UBaseType_t ) 0U )
+                {
+                    return pdFAIL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            *pxMessage = xBatch[ uxBatchNext ];
+            uxBatchNext++;
+
+            return pdPASS;
+        }
+
+    #endif /* configTIMER_COMMAND_BATCH */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -1120,10 +1504,27 @@
         {
             if( xTimerQueue == NULL )
             {
+                #if ( configUSE_TIMER_WHEEL == 0 )
                 vListInitialise( &xActiveTimerList1 );
                 vListInitialise( &xActiveTimerList2 );
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
+                #endif /* configUSE_TIMER_WHEEL */
+
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel;
+                    UBaseType_t uxSlot;
+
+                    for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+                    }
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
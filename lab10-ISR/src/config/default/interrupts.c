@@ -50,6 +50,7 @@
 // *****************************************************************************
 #include "interrupts.h"
 #include "definitions.h"
+#include "system/latency/sys_latency.h"
 
 
 
@@ -82,11 +83,15 @@ void UART6_TX_Handler (void);
 
 void __attribute__((used)) CHANGE_NOTICE_J_Handler (void)
 {
+    SYS_LATENCY_IsrEnter(SYS_LATENCY_PATH_CHANGE_NOTICE_J);
+
     CHANGE_NOTICE_J_InterruptHandler();
 }
 
 void __attribute__((used)) DMA0_Handler (void)
 {
+    SYS_LATENCY_IsrEnter(SYS_LATENCY_PATH_DMA0);
+
     DMA0_InterruptHandler();
 }
 
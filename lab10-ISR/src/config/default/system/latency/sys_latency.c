@@ -0,0 +1,189 @@
+/*******************************************************************************
+  System Interrupt Latency Service
+
+  File Name:
+    sys_latency.c
+
+  Summary:
+    Interrupt entry to task run latency histograms.
+
+  Description:
+    The bucket of a latency v >= 4 is given by its highest set bit e and the
+    two bits below it: 4 * (e - 1) + those two bits.  One count leading zeros
+    and a shift, no division, since it runs inside a critical section.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_latency.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Written by the handler on every entry */
+    uint32_t entry;
+
+    /* Entry of the oldest interrupt that woke the task, valid if armed */
+    uint32_t start;
+    bool armed;
+
+    SYS_LATENCY_STATISTICS stats;
+
+} SYS_LATENCY_OBJ;
+
+static SYS_LATENCY_OBJ sysLatencyObj[SYS_LATENCY_PATH_COUNT];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t SYS_LATENCY_Bucket( uint32_t ticks )
+{
+    uint32_t e;
+
+    if (ticks < 4U)
+    {
+        return ticks;
+    }
+
+    e = 31U - _clz(ticks);
+
+    return ((e - 1U) * 4U) + ((ticks >> (e - 2U)) & 3U);
+}
+
+static uint32_t SYS_LATENCY_BucketTop( uint32_t bucket )
+{
+    uint32_t e;
+
+    if (bucket < 4U)
+    {
+        return bucket;
+    }
+
+    e = (bucket / 4U) + 1U;
+
+    /* Wraps to 0xFFFFFFFF for the last bucket, which is its top */
+    return (((4U + (bucket % 4U)) << (e - 2U)) + (1UL << (e - 2U))) - 1U;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_LATENCY_IsrEnter( SYS_LATENCY_PATH path )
+{
+    sysLatencyObj[path].entry = _CP0_GET_COUNT();
+}
+
+void SYS_LATENCY_IsrWake( SYS_LATENCY_PATH path )
+{
+    SYS_LATENCY_OBJ *obj = &sysLatencyObj[path];
+    UBaseType_t uxSavedStatus;
+
+    uxSavedStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    if (obj->armed == false)
+    {
+        obj->start = obj->entry;
+        obj->armed = true;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedStatus);
+}
+
+void SYS_LATENCY_TaskRun( SYS_LATENCY_PATH path )
+{
+    SYS_LATENCY_OBJ *obj = &sysLatencyObj[path];
+    SYS_LATENCY_STATISTICS *stats = &obj->stats;
+    uint32_t now = _CP0_GET_COUNT();
+    uint32_t ticks;
+
+    taskENTER_CRITICAL();
+
+    if (obj->armed == true)
+    {
+        obj->armed = false;
+        ticks = now - obj->start;
+
+        if ((stats->count == 0U) || (ticks < stats->min))
+        {
+            stats->min = ticks;
+        }
+        if (ticks > stats->max)
+        {
+            stats->max = ticks;
+        }
+        stats->sum += ticks;
+        stats->count++;
+        stats->bucket[SYS_LATENCY_Bucket(ticks)]++;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+void SYS_LATENCY_StatisticsGet( SYS_LATENCY_PATH path, SYS_LATENCY_STATISTICS *stats )
+{
+    taskENTER_CRITICAL();
+    (void)memcpy(stats, &sysLatencyObj[path].stats, sizeof(SYS_LATENCY_STATISTICS));
+    taskEXIT_CRITICAL();
+}
+
+void SYS_LATENCY_Reset( SYS_LATENCY_PATH path )
+{
+    taskENTER_CRITICAL();
+    (void)memset(&sysLatencyObj[path].stats, 0, sizeof(SYS_LATENCY_STATISTICS));
+    sysLatencyObj[path].armed = false;
+    taskEXIT_CRITICAL();
+}
+
+uint32_t SYS_LATENCY_Percentile( const SYS_LATENCY_STATISTICS *stats, uint32_t permille )
+{
+    uint32_t target;
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    if (stats->count == 0U)
+    {
+        return 0U;
+    }
+
+    /* Rank of the sample, rounded up and at least the first one */
+    target = (uint32_t)((((uint64_t)stats->count * permille) + 999U) / 1000U);
+    if (target == 0U)
+    {
+        target = 1U;
+    }
+
+    for (i = 0U; i < SYS_LATENCY_BUCKETS; i++)
+    {
+        sum += stats->bucket[i];
+        if (sum >= target)
+        {
+            break;
+        }
+    }
+
+    if ((i >= SYS_LATENCY_BUCKETS) || (SYS_LATENCY_BucketTop(i) > stats->max))
+    {
+        return stats->max;
+    }
+
+    return SYS_LATENCY_BucketTop(i);
+}
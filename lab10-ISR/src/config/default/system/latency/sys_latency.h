@@ -0,0 +1,175 @@
+/*******************************************************************************
+  System Interrupt Latency Service
+
+  File Name:
+    sys_latency.h
+
+  Summary:
+    Interrupt entry to task run latency histograms.
+
+  Description:
+    A path is an interrupt that wakes a task.  Its time is taken from the CP0
+    Count register (SYSCLK / 2, 10 ns) at three points:
+
+      SYS_LATENCY_IsrEnter   first thing in the handler of interrupts.c
+      SYS_LATENCY_IsrWake    in the callback, when it really gives / sends
+                             something to the task
+      SYS_LATENCY_TaskRun    in the task, when the blocking call returned
+
+    The latency is TaskRun minus IsrEnter of the interrupt that was armed by
+    IsrWake.  Interrupts that wake nothing (a bounce, a released button) are
+    not measured.  When several wakes happen before the task runs the oldest
+    one counts, the others are waiting as well.  The context save done by
+    the assembly wrapper before the C handler is not included.
+
+    Each path has a min / max / mean and a histogram with 4 buckets per
+    power of two, so a percentile is known within 25 % over the whole 32 bit
+    range.
+*******************************************************************************/
+
+#ifndef SYS_LATENCY_H
+#define SYS_LATENCY_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <xc.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Counter ticks per second: the core timer runs at SYSCLK / 2. */
+#define SYS_LATENCY_COUNTER_HZ          (100000000UL)
+
+/* Histogram buckets: 0..3 exactly, then 4 per power of two up to 2^32. */
+#define SYS_LATENCY_BUCKETS             (124U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Measured paths, one per handler in interrupts.c */
+typedef enum
+{
+    SYS_LATENCY_PATH_CHANGE_NOTICE_J = 0,
+    SYS_LATENCY_PATH_DMA0,
+
+    SYS_LATENCY_PATH_COUNT
+
+} SYS_LATENCY_PATH;
+
+typedef struct
+{
+    uint32_t count;
+    /* Counter ticks */
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+
+    uint32_t bucket[SYS_LATENCY_BUCKETS];
+
+} SYS_LATENCY_STATISTICS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_LATENCY_IsrEnter( SYS_LATENCY_PATH path )
+
+  Summary:
+    Time stamp of the latest entry into the handler of path.
+*/
+void SYS_LATENCY_IsrEnter( SYS_LATENCY_PATH path );
+
+// *****************************************************************************
+/* Function:
+    void SYS_LATENCY_IsrWake( SYS_LATENCY_PATH path )
+
+  Summary:
+    The interrupt being handled passes work to the task of path.
+
+  Description:
+    Interrupt context, after SYS_LATENCY_IsrEnter of the same path.
+*/
+void SYS_LATENCY_IsrWake( SYS_LATENCY_PATH path );
+
+// *****************************************************************************
+/* Function:
+    void SYS_LATENCY_TaskRun( SYS_LATENCY_PATH path )
+
+  Summary:
+    The task of path runs, adds the latency of the armed interrupt if any.
+*/
+void SYS_LATENCY_TaskRun( SYS_LATENCY_PATH path );
+
+// *****************************************************************************
+/* Function:
+    void SYS_LATENCY_StatisticsGet( SYS_LATENCY_PATH path,
+                                    SYS_LATENCY_STATISTICS *stats )
+    void SYS_LATENCY_Reset( SYS_LATENCY_PATH path )
+
+  Summary:
+    Copy or clear the statistics of path, task context.
+*/
+void SYS_LATENCY_StatisticsGet( SYS_LATENCY_PATH path, SYS_LATENCY_STATISTICS *stats );
+
+void SYS_LATENCY_Reset( SYS_LATENCY_PATH path );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_LATENCY_Percentile( const SYS_LATENCY_STATISTICS *stats,
+                                     uint32_t permille )
+
+  Summary:
+    Latency that permille / 1000 of the samples did not exceed.
+
+  Description:
+    The upper edge of the bucket holding that sample, never above max.
+    0 without samples.
+*/
+uint32_t SYS_LATENCY_Percentile( const SYS_LATENCY_STATISTICS *stats, uint32_t permille );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_LATENCY_ToUs( uint32_t ticks )
+
+  Summary:
+    Counter ticks to microseconds, rounded.
+*/
+static inline uint32_t SYS_LATENCY_ToUs( uint32_t ticks )
+{
+    return (uint32_t)((ticks + ((SYS_LATENCY_COUNTER_HZ / 1000000UL) / 2U)) / (SYS_LATENCY_COUNTER_HZ / 1000000UL));
+}
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_LATENCY_H
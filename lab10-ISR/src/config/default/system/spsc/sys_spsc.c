@@ -0,0 +1,134 @@
+/*******************************************************************************
+  System Single Producer Single Consumer Ring Service
+
+  File Name:
+    sys_spsc.c
+
+  Summary:
+    Lock-free ring for passing items from one interrupt to one task.
+
+  Description:
+    The consumer checks the ring before it blocks and the notification
+    counts, so an item written between the check and ulTaskNotifyTake makes
+    the take return at once.  A notification left over from an item that
+    was already read only causes one more empty check.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_spsc.h"
+
+#if (SYS_SPSC_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+    #error SYS_SPSC_NOTIFY_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_SPSC_Create( SYS_SPSC *ring, void *storage, size_t itemSize, uint32_t length )
+{
+    if ((length == 0U) || ((length & (length - 1U)) != 0U))
+    {
+        return false;
+    }
+
+    ring->storage = (uint8_t *)storage;
+    ring->itemSize = itemSize;
+    ring->length = length;
+    ring->head = 0U;
+    ring->tail = 0U;
+    ring->consumer = NULL;
+
+    return true;
+}
+
+bool SYS_SPSC_Write( SYS_SPSC *ring, const void *item )
+{
+    uint32_t head = ring->head;
+
+    if ((head - ring->tail) >= ring->length)
+    {
+        return false;
+    }
+
+    (void)memcpy(&ring->storage[(head & (ring->length - 1U)) * ring->itemSize], item, ring->itemSize);
+
+    /* The item is complete before the consumer can see it */
+    SYS_SPSC_BARRIER();
+    ring->head = head + 1U;
+
+    return true;
+}
+
+bool SYS_SPSC_SendFromISR( SYS_SPSC *ring, const void *item, BaseType_t *pxHigherPriorityTaskWoken )
+{
+    TaskHandle_t consumer;
+
+    if (SYS_SPSC_Write(ring, item) == false)
+    {
+        return false;
+    }
+
+    consumer = ring->consumer;
+    if (consumer != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(consumer, SYS_SPSC_NOTIFY_INDEX, pxHigherPriorityTaskWoken);
+    }
+
+    return true;
+}
+
+bool SYS_SPSC_Read( SYS_SPSC *ring, void *item )
+{
+    uint32_t tail = ring->tail;
+
+    if (ring->head == tail)
+    {
+        return false;
+    }
+
+    /* The head was read before the item it publishes */
+    SYS_SPSC_BARRIER();
+    (void)memcpy(item, &ring->storage[(tail & (ring->length - 1U)) * ring->itemSize], ring->itemSize);
+
+    /* The copy is done before the producer may overwrite the slot */
+    SYS_SPSC_BARRIER();
+    ring->tail = tail + 1U;
+
+    return true;
+}
+
+bool SYS_SPSC_Receive( SYS_SPSC *ring, void *item, TickType_t xTicksToWait )
+{
+    TimeOut_t xTimeOut;
+
+    if (ring->consumer == NULL)
+    {
+        ring->consumer = xTaskGetCurrentTaskHandle();
+    }
+    configASSERT(ring->consumer == xTaskGetCurrentTaskHandle());
+
+    vTaskSetTimeOutState(&xTimeOut);
+
+    while (SYS_SPSC_Read(ring, item) == false)
+    {
+        if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdTRUE)
+        {
+            return false;
+        }
+
+        (void)ulTaskNotifyTakeIndexed(SYS_SPSC_NOTIFY_INDEX, pdTRUE, xTicksToWait);
+    }
+
+    return true;
+}
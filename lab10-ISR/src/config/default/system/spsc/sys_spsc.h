@@ -0,0 +1,168 @@
+/*******************************************************************************
+  System Single Producer Single Consumer Ring Service
+
+  File Name:
+    sys_spsc.h
+
+  Summary:
+    Lock-free ring for passing items from one interrupt to one task.
+
+  Description:
+    A FreeRTOS queue serves any number of senders and receivers, so every
+    send takes a critical section and looks at the lists of waiting tasks.
+    An interrupt handler that feeds exactly one task needs neither.
+
+    The ring has a write index owned by the producer and a read index owned
+    by the consumer.  Each side only stores its own index and only reads the
+    other one, the item is copied before the write index moves and after
+    the read index was seen, with a memory barrier in between.  Nothing on
+    the data path masks interrupts, so SYS_SPSC_Write may be called from an
+    interrupt of any priority, also above configMAX_SYSCALL_INTERRUPT_PRIORITY.
+
+    The consumer task blocks on a task notification.  SYS_SPSC_SendFromISR
+    writes and notifies; it is a FreeRTOS call and has the usual priority
+    limit.  A producer above that limit uses SYS_SPSC_Write and the consumer
+    finds its items at the end of the block time given to SYS_SPSC_Receive,
+    which then acts as a poll period.
+*******************************************************************************/
+
+#ifndef SYS_SPSC_H
+#define SYS_SPSC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Notification index the consumer blocks on. */
+#ifndef SYS_SPSC_NOTIFY_INDEX
+    #define SYS_SPSC_NOTIFY_INDEX       (0U)
+#endif
+
+/* Orders the item copy against the index store.  The PIC32MZ core has a
+   single hart, a sync keeps the compiler and the write buffer in order. */
+#ifndef SYS_SPSC_BARRIER
+    #define SYS_SPSC_BARRIER()          __sync_synchronize()
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* One ring.  Allocated by the application, set up by SYS_SPSC_Create. */
+typedef struct
+{
+    uint8_t *storage;
+    size_t itemSize;
+    /* Power of two */
+    uint32_t length;
+
+    /* Free running, head - tail items are stored */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+
+    /* Task blocked in SYS_SPSC_Receive, NULL before its first call */
+    TaskHandle_t volatile consumer;
+
+} SYS_SPSC;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SPSC_Create( SYS_SPSC *ring, void *storage, size_t itemSize,
+                          uint32_t length )
+
+  Summary:
+    Sets up ring over storage of length items of itemSize bytes.
+
+  Description:
+    Returns false if length is not a power of two.
+*/
+bool SYS_SPSC_Create( SYS_SPSC *ring, void *storage, size_t itemSize, uint32_t length );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SPSC_Write( SYS_SPSC *ring, const void *item )
+
+  Summary:
+    Copies item into the ring, producer side, any context and priority.
+
+  Description:
+    Returns false if the ring is full.  Does not wake the consumer.
+*/
+bool SYS_SPSC_Write( SYS_SPSC *ring, const void *item );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SPSC_SendFromISR( SYS_SPSC *ring, const void *item,
+                               BaseType_t *pxHigherPriorityTaskWoken )
+
+  Summary:
+    SYS_SPSC_Write, then notifies the consumer.
+
+  Description:
+    Interrupt at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.  Ends like
+    any FromISR call with portEND_SWITCHING_ISR.
+*/
+bool SYS_SPSC_SendFromISR( SYS_SPSC *ring, const void *item, BaseType_t *pxHigherPriorityTaskWoken );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SPSC_Read( SYS_SPSC *ring, void *item )
+
+  Summary:
+    Copies the oldest item out of the ring, consumer side, never blocks.
+*/
+bool SYS_SPSC_Read( SYS_SPSC *ring, void *item );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_SPSC_Receive( SYS_SPSC *ring, void *item,
+                           TickType_t xTicksToWait )
+
+  Summary:
+    SYS_SPSC_Read, waiting up to xTicksToWait for an item.
+
+  Description:
+    Always called by the same task, which becomes the consumer on the first
+    call.  Returns false on timeout.
+*/
+bool SYS_SPSC_Receive( SYS_SPSC *ring, void *item, TickType_t xTicksToWait );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_SPSC_H
@@ -18,9 +18,10 @@
  *		Mutex
  *		Binary Semaphore
  *		Custom struct
- *		Static Queue (tenQueue)
+ *		Lock-free SPSC ring (xBtnRing, system/spsc)
 		Static Task 
  *		ISR callback (Btn1Handler)
+ *		Interrupt to task latency (system/latency)
 
   Summary:
     Queues are the primary mechanism for inter-task communications. They can be used
@@ -32,6 +33,10 @@ to send messages between tasks, and between interrupts and tasks. these lines of
     "main" function calls the "SYS_Initialize" function to initialize the state
     machines of all modules in the system. Debug messages are showed via UART6. 
  * DMA module is using to make the task/CPU unblock and transmission continues in background.
+ * Each button message is followed by the latency from the CHANGE_NOTICE_J / DMA0 handler to the task Receive
+ * running again: min, 50th, 99th percentile and max in microseconds.
+ * The button handler passes its struct through a single producer single consumer ring, without critical
+ * section, at start task Receive compares it in cpu cycles with a static queue and xQueueSendFromISR.
  *******************************************************************************/
 
 // *****************************************************************************
@@ -52,10 +57,12 @@ to send messages between tasks, and between interrupts and tasks. these lines of
 #include "semphr.h"
 #include "queue.h"
 #include "device_cache.h"
+#include "system/latency/sys_latency.h"
+#include "system/spsc/sys_spsc.h"
 
 
-//define constants of the queue
-#define QUEUE_LENGTH 5
+//define constants of the ring, the length is a power of two
+#define RING_LENGTH 8
 #define UNIT_SIZE sizeof(BtnStatus_t) 
 
 //active-low button
@@ -78,14 +85,20 @@ SemaphoreHandle_t xMutex;
 SemaphoreHandle_t xBinarySema;
 
 //declare variables of uart6 buffer
-static uint8_t __attribute__ ((aligned (16))) u6TxBuffer[150] = {0};
+static uint8_t __attribute__ ((aligned (16))) u6TxBuffer[200] = {0};
 
-//declare a queue
-QueueHandle_t tenQueue;
-//declare memory of the queue
-static uint8_t xQueueQcbBuffer[QUEUE_LENGTH * UNIT_SIZE];
-//declare static queue object
-static StaticQueue_t xQueueObj;
+//declare the ring from Btn1Handler to task Receive
+static SYS_SPSC xBtnRing;
+//declare memory of the ring
+static uint8_t xRingBuffer[RING_LENGTH * UNIT_SIZE];
+
+//declare a queue and a ring of the same items, only for the benchmark of task Receive
+#define BENCH_ROUNDS 100
+static QueueHandle_t xBenchQueue;
+static uint8_t xBenchQueueBuffer[RING_LENGTH * UNIT_SIZE];
+static StaticQueue_t xBenchQueueObj;
+static SYS_SPSC xBenchRing;
+static uint8_t xBenchRingBuffer[RING_LENGTH * UNIT_SIZE];
 
 static void Debug_msg(char * msg){
 	while (*msg){
@@ -100,6 +113,7 @@ static void U6D0Handler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
 	if (event == DMAC_TRANSFER_EVENT_COMPLETE){
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 		xSemaphoreGiveFromISR(xBinarySema, &xHigherPriorityTaskWoken);
+		SYS_LATENCY_IsrWake(SYS_LATENCY_PATH_DMA0);
 		portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 	}
 }
@@ -115,13 +129,14 @@ static void Btn1Handler(GPIO_PIN pin, uintptr_t context){
 	
 	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 	if (BTN1_Get() == BTN1_PRESSED_STATE){
-		if ( xQueueSendFromISR(
-			tenQueue,
+		if ( SYS_SPSC_SendFromISR(
+			&xBtnRing,
 			&btnOne,
-			&xHigherPriorityTaskWoken) == pdFAIL){
+			&xHigherPriorityTaskWoken) == false){
 				Debug_msg("cannot send object from ISR\r\n");
 				exit(EXIT_FAILURE);
 		}
+		SYS_LATENCY_IsrWake(SYS_LATENCY_PATH_CHANGE_NOTICE_J);
 		
 		portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 	}
@@ -172,14 +187,22 @@ int main ( void )
 				Debug_msg("cannot create the task \r\n");
 				return(EXIT_FAILURE);
 	}
-	//create the queue - static
-	tenQueue = xQueueCreateStatic(
-		QUEUE_LENGTH,
+	//create the ring - static
+	if (SYS_SPSC_Create(
+		&xBtnRing,
+		xRingBuffer,
+		UNIT_SIZE,
+		RING_LENGTH) == false){ 
+		Debug_msg("cannot create the ring \r\n");
+		return(EXIT_FAILURE);}
+	//create the queue and the ring of the benchmark - static
+	xBenchQueue = xQueueCreateStatic(
+		RING_LENGTH,
 		UNIT_SIZE,
-		xQueueQcbBuffer,
-		&(xQueueObj));
-	if (tenQueue == NULL){ 
-		Debug_msg("cannot create the queue \r\n");
+		xBenchQueueBuffer,
+		&(xBenchQueueObj));
+	if ((xBenchQueue == NULL) || (SYS_SPSC_Create(&xBenchRing, xBenchRingBuffer, UNIT_SIZE, RING_LENGTH) == false)){ 
+		Debug_msg("cannot create the benchmark queues \r\n");
 		return(EXIT_FAILURE);}
 	
 	vTaskStartScheduler();
@@ -196,19 +219,72 @@ int main ( void )
 	return ( EXIT_FAILURE );
 }
 
+//format the latency of one path: min, 50th, 99th percentile and max in microseconds
+//returns the length of the text, truncated to fit into size
+static size_t prvFormatLatency(char * buf, size_t size, const char * name, SYS_LATENCY_PATH path){
+	static SYS_LATENCY_STATISTICS xStats;
+	int len;
+	SYS_LATENCY_StatisticsGet(path, &xStats);
+	len = snprintf(buf, size, "%s n %lu min %lu p50 %lu p99 %lu max %lu us\r\n",
+			name,
+			(unsigned long)xStats.count,
+			(unsigned long)SYS_LATENCY_ToUs(xStats.min),
+			(unsigned long)SYS_LATENCY_ToUs(SYS_LATENCY_Percentile(&xStats, 500)),
+			(unsigned long)SYS_LATENCY_ToUs(SYS_LATENCY_Percentile(&xStats, 990)),
+			(unsigned long)SYS_LATENCY_ToUs(xStats.max));
+	if (len < 0){
+		return 0;
+	}
+	return ((size_t)len < size) ? (size_t)len : size - 1;
+}
+
+//measure the core timer for BENCH_ROUNDS send+receive of one BtnStatus_t, queue vs ring
+//the send side is the one of Btn1Handler, called from the task with nobody waiting
+static void prvBenchmark(void){
+	static BtnStatus_t xItem;
+	BaseType_t xWoken = pdFALSE;
+	uint32_t start;
+	uint32_t queueTicks;
+	uint32_t ringTicks;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+		xQueueSendFromISR(xBenchQueue, &btnOne, &xWoken);
+		xQueueReceive(xBenchQueue, &xItem, 0);
+	}
+	queueTicks = _CP0_GET_COUNT() - start;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+		SYS_SPSC_Write(&xBenchRing, &btnOne);
+		SYS_SPSC_Read(&xBenchRing, &xItem);
+	}
+	ringTicks = _CP0_GET_COUNT() - start;
+	
+	//the core timer counts every second cpu cycle
+	snprintf((char *)u6TxBuffer, sizeof(u6TxBuffer),
+			"send+receive of %u bytes: queue %lu cycles, spsc ring %lu cycles\r\n",
+			(unsigned)UNIT_SIZE,
+			(unsigned long)((queueTicks * 2) / BENCH_ROUNDS),
+			(unsigned long)((ringTicks * 2) / BENCH_ROUNDS));
+}
+
 static void prvTaskReceiveFunction(void * pvParams){
 	//stop warning of unused parameter
 	(void) pvParams;
 	if (xSemaphoreTake(xMutex, portMAX_DELAY) ==pdTRUE){
 		Debug_msg("hello task Receive is at work-please press button 1 \r\n");
+		prvBenchmark();
+		Debug_msg((char *)u6TxBuffer);
 		xSemaphoreGive(xMutex);
 	}
 	BtnStatus_t localReceive;
 	for (;;){
-		//receiving data structure from the queue
-		if (xQueueReceive(	tenQueue,
+		//receiving data structure from the ring
+		if (SYS_SPSC_Receive(	&xBtnRing,
 				&localReceive,
-				portMAX_DELAY) == pdPASS){
+				portMAX_DELAY) == true){
+			SYS_LATENCY_TaskRun(SYS_LATENCY_PATH_CHANGE_NOTICE_J);
 
 			//format string
 			sprintf((char *)u6TxBuffer, "%s", localReceive.info_msg);
@@ -225,6 +301,21 @@ static void prvTaskReceiveFunction(void * pvParams){
 					strlen((const char *)u6TxBuffer),
 					(const void *)&U6TXREG, 1, 1);
 				xSemaphoreTake(xBinarySema, portMAX_DELAY);
+				SYS_LATENCY_TaskRun(SYS_LATENCY_PATH_DMA0);
+
+				//show the latency of both paths, the message above is already measured
+				size_t len = prvFormatLatency((char *)u6TxBuffer, sizeof(u6TxBuffer), "latency btn", SYS_LATENCY_PATH_CHANGE_NOTICE_J);
+				prvFormatLatency((char *)u6TxBuffer + len, sizeof(u6TxBuffer) - len, "latency dma", SYS_LATENCY_PATH_DMA0);
+				DCACHE_CLEAN_BY_ADDR(
+					(uint32_t)u6TxBuffer,
+					strlen((char *)u6TxBuffer));
+				DMAC_ChannelTransfer(
+					DMAC_CHANNEL_0,
+					(const void *)u6TxBuffer,
+					strlen((const char *)u6TxBuffer),
+					(const void *)&U6TXREG, 1, 1);
+				xSemaphoreTake(xBinarySema, portMAX_DELAY);
+				SYS_LATENCY_TaskRun(SYS_LATENCY_PATH_DMA0);
 				xSemaphoreGive(xMutex);
 			}
 		}
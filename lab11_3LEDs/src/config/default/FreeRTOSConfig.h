@@ -88,8 +88,10 @@
 /* configMINIMAL_STACK_SIZE defines the size of the stack used by the Idle task
  * (in words, not in bytes!).  The kernel does not use this constant for any other
  * purpose.  Demo applications use the constant to make the demos somewhat portable
- * across hardware architectures. */
-#define configMINIMAL_STACK_SIZE                ( 256 )
+ * across hardware architectures.  The 66 words on top of the usual 256 make up
+ * for the 264 byte FPU save area that configUSE_TASK_FPU_SUPPORT 2 reserves at
+ * the top of every task stack. */
+#define configMINIMAL_STACK_SIZE                ( 256 + 66 )
 
 /* configMAX_TASK_NAME_LEN sets the maximum length (in characters) of a task's
  * human readable name.  Includes the NULL terminator. */
@@ -385,7 +387,10 @@
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_QUEUE_SETS                    0
 #define configUSE_APPLICATION_TASK_TAG          0
-#define configUSE_TASK_FPU_SUPPORT              0
+/* 2 switches the FPU lazily for every task, each task stack holds a 264 byte
+ * FPU save area.  1 saves it on every switch of tasks that called
+ * portTASK_USES_FLOATING_POINT(). */
+#define configUSE_TASK_FPU_SUPPORT              2
 
 
 /* Set the following INCLUDE_* constants to 1 to incldue the named API function,
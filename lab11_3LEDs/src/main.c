@@ -56,6 +56,14 @@
 
 #define SW_PRESS_STATE 0
 
+//context switch benchmark: pairs of tasks pass a notification back and forth, one pair
+//without FP code, one where only the ping task does FP math and one where both tasks do
+#define SWITCH_BENCH_ROUNDS	1000
+#define SWITCH_BENCH_PAIRS	3
+#define SWITCH_BENCH_PRIORITY	(tskIDLE_PRIORITY + 2)
+//the core timer runs at half the cpu clock
+#define CORE_TIMER_CYCLES(count)	((count) * 2U)
+
 //declare static variable for identifying LEDs
 //0 for Red; 1 for Green; 2 for Yellow
 static uint8_t whichLED = 0;
@@ -106,6 +114,30 @@ static void (*fp_Led[3])(void) = {vRedToggle, vGreenToggle, vYellowToggle};
 //declare buffer for UART6
 static uint8_t __attribute__ ((aligned (16))) u6TxBuffer[100] = {0};
 
+//declare the benchmark pairs, cycles holds the core timer counts of all rounds
+typedef struct {
+	const char * name;
+	bool pingFP;
+	bool pongFP;
+	TaskHandle_t ping;
+	TaskHandle_t pong;
+	uint32_t cycles;
+} SWITCH_BENCH_PAIR;
+
+static SWITCH_BENCH_PAIR xBenchPair[SWITCH_BENCH_PAIRS] = {
+	{"int/int", false, false, NULL, NULL, 0},
+	{"fp/int", true, false, NULL, NULL, 0},
+	{"fp/fp", true, true, NULL, NULL, 0},
+};
+
+static StackType_t xBenchStack[SWITCH_BENCH_PAIRS * 2][configMINIMAL_STACK_SIZE];
+static StaticTask_t xBenchTCBBuffer[SWITCH_BENCH_PAIRS * 2];
+static StackType_t xBenchControlStack[configMINIMAL_STACK_SIZE * 2];
+static StaticTask_t xBenchControlTCBBuffer;
+static TaskHandle_t xBenchControl = NULL;
+
+static volatile float fBenchAcc = 1.0f;
+
 //declare a function to display the debug messages
 static void Debug_msg(char * msg){
 	while (*msg){
@@ -152,6 +184,95 @@ static void SW3Callback(GPIO_PIN pin, uintptr_t context){
 	}
 }
 
+//declare the benchmark tasks
+static void prvBenchFP(bool fp){
+	if (fp){
+		fBenchAcc = fBenchAcc * 1.0001f + 0.5f;
+	}
+}
+
+static void prvBenchPongTask(void * pvParams){
+	SWITCH_BENCH_PAIR * pair = (SWITCH_BENCH_PAIR *)pvParams;
+#if (configUSE_TASK_FPU_SUPPORT == 1)
+	if (pair->pongFP){
+		portTASK_USES_FLOATING_POINT();
+	}
+#endif
+	while (true){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		prvBenchFP(pair->pongFP);
+		xTaskNotifyGive(pair->ping);
+	}
+}
+
+//each round is two switches, ping to pong and back
+static void prvBenchPingTask(void * pvParams){
+	SWITCH_BENCH_PAIR * pair = (SWITCH_BENCH_PAIR *)pvParams;
+#if (configUSE_TASK_FPU_SUPPORT == 1)
+	if (pair->pingFP){
+		portTASK_USES_FLOATING_POINT();
+	}
+#endif
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	uint32_t start = _CP0_GET_COUNT();
+	for (uint32_t round = 0; round < SWITCH_BENCH_ROUNDS; round++){
+		prvBenchFP(pair->pingFP);
+		xTaskNotifyGive(pair->pong);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+	pair->cycles = _CP0_GET_COUNT() - start;
+	
+	//deleting pong also drops it as FPU owner
+	vTaskDelete(pair->pong);
+	xTaskNotifyGive(xBenchControl);
+	vTaskDelete(NULL);
+}
+
+//run the pairs one after the other and show the cycles per switch
+static void prvBenchControlTask(void * pvParams){
+	(void)pvParams;
+	for (uint8_t i = 0; i < SWITCH_BENCH_PAIRS; i++){
+		SWITCH_BENCH_PAIR * pair = &xBenchPair[i];
+		//the pair runs below this task, only once it waits for the result
+		pair->ping = xTaskCreateStatic(
+				prvBenchPingTask,
+				"bench ping",
+				configMINIMAL_STACK_SIZE,
+				(void *)pair,
+				SWITCH_BENCH_PRIORITY,
+				xBenchStack[i * 2],
+				&xBenchTCBBuffer[i * 2]);
+		pair->pong = xTaskCreateStatic(
+				prvBenchPongTask,
+				"bench pong",
+				configMINIMAL_STACK_SIZE,
+				(void *)pair,
+				SWITCH_BENCH_PRIORITY,
+				xBenchStack[i * 2 + 1],
+				&xBenchTCBBuffer[i * 2 + 1]);
+		xTaskNotifyGive(pair->ping);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		
+		if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
+			sprintf((char *)u6TxBuffer, "context switch %s: %lu cycles, fpu support %d \r\n",
+						pair->name,
+						(unsigned long)(CORE_TIMER_CYCLES(pair->cycles) / (2U * SWITCH_BENCH_ROUNDS)),
+						configUSE_TASK_FPU_SUPPORT);
+			DCACHE_CLEAN_BY_ADDR(
+						(uint32_t)u6TxBuffer,
+						strlen((const char *)u6TxBuffer));
+			DMAC_ChannelTransfer(
+					DMAC_CHANNEL_0,
+					(const void *)u6TxBuffer,
+					strlen((const char *)u6TxBuffer),
+					(const void *)&U6TXREG, 1, 1);
+			xSemaphoreTake(xBinarySema, portMAX_DELAY);
+			xSemaphoreGive(xMutex);
+		}
+	}
+	vTaskDelete(NULL);
+}
+
 //declare the function of application initialize
 static void APP_Initialize(void){
 	
@@ -259,6 +380,16 @@ int main ( void )
 		return (EXIT_FAILURE);
 		}
     
+    //create the context switch benchmark
+    xBenchControl = xTaskCreateStatic(
+			prvBenchControlTask,
+			"bench control",
+			configMINIMAL_STACK_SIZE * 2,
+			NULL,
+			SWITCH_BENCH_PRIORITY + 1,
+			xBenchControlStack,
+			&xBenchControlTCBBuffer);
+    
     //start auto-reload timer
     if (xTimerStart(
 	    xIntervalTimer,
@@ -348,7 +348,7 @@
  * are used by trace and visualisation functions and tools.  Set to 0 to exclude
  * the additional information from the structures. Defaults to 0 if left
  * undefined. */
-#define configUSE_TRACE_FACILITY                0
+#define configUSE_TRACE_FACILITY                1
 
 /* Set to 1 to include the vTaskList() and vTaskGetRunTimeStats() functions in
  * the build.  Set to 0 to exclude these functions from the build.  These two
@@ -357,6 +357,65 @@
  * undefined. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/******************************************************************************/
+/* Trace hook definitions. ****************************************************/
+/******************************************************************************/
+
+/* The kernel trace macros store binary records in the RAM ring of
+ * system/trace/sys_trace.c.  The task macros expand inside tasks.c and the
+ * queue macros inside queue.c, where pxCurrentTCB and the TCB / Queue_t
+ * members they read are visible.  Set SYS_TRACE_TICKS to 1 to record ticks. */
+#ifndef __LANGUAGE_ASSEMBLY
+    #include "system/trace/sys_trace.h"
+
+    #define traceTASK_SWITCHED_IN() \
+        SYS_TRACE_TaskSwitchedIn( pxCurrentTCB->uxTCBNumber, pxCurrentTCB->uxPriority )
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_TASK_READY, ( uint16_t ) ( pxTCB )->uxTCBNumber )
+    #define traceTASK_DELAY() \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_TASK_DELAY, 0U )
+    #define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_PRIORITY_INHERIT, \
+                          ( uint16_t ) ( ( ( pxTCBOfMutexHolder )->uxTCBNumber << 8 ) | ( uxInheritedPriority ) ) )
+    #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_PRIORITY_DISINHERIT, \
+                          ( uint16_t ) ( ( ( pxTCBOfMutexHolder )->uxTCBNumber << 8 ) | ( uxOriginalPriority ) ) )
+
+    #define traceQUEUE_CREATE( pxNewQueue )                                 \
+        do                                                                  \
+        {                                                                   \
+            ( pxNewQueue )->uxQueueNumber = SYS_TRACE_QueueNumberNext();    \
+            SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_CREATE,                 \
+                              ( uint16_t ) ( pxNewQueue )->uxQueueNumber ); \
+        } while( 0 )
+    #define traceCREATE_MUTEX( pxNewQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_MUTEX_CREATE, ( uint16_t ) ( pxNewQueue )->uxQueueNumber )
+    #define traceQUEUE_SEND( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_SEND, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceQUEUE_SEND_FAILED( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_SEND_FAILED, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_SEND_BLOCK, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceQUEUE_RECEIVE( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_RECEIVE, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceQUEUE_RECEIVE_FAILED( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_RECEIVE_FAILED, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_RECEIVE_BLOCK, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceQUEUE_SEND_FROM_ISR( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_SEND_FROM_ISR, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+    #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue ) \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+
+    #define traceISR_EXIT_TO_SCHEDULER() \
+        SYS_TRACE_Record( SYS_TRACE_EVENT_ISR_YIELD, 0U )
+
+    #if ( SYS_TRACE_TICKS == 1 )
+        #define traceTASK_INCREMENT_TICK( xTickCount ) \
+            SYS_TRACE_Record( SYS_TRACE_EVENT_TICK, ( uint16_t ) ( xTickCount ) )
+    #endif
+#endif
+
 /******************************************************************************/
 /* Co-routine related definitions. ********************************************/
 /******************************************************************************/
@@ -381,6 +440,7 @@
  * the build, or 0 to exclude the named feature from the build. */
 #define configUSE_TASK_NOTIFICATIONS            1
 #define configUSE_MUTEXES                       1
+#define configUSE_MUTEX_PRIORITY_CEILING        1
 #define configUSE_RECURSIVE_MUTEXES             0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_QUEUE_SETS                    0
@@ -50,6 +50,7 @@
 // *****************************************************************************
 #include "interrupts.h"
 #include "definitions.h"
+#include "system/trace/sys_trace.h"
 
 
 
@@ -78,7 +79,11 @@ void DMA0_Handler (void);
 
 void __attribute__((used)) DMA0_Handler (void)
 {
+    SYS_TRACE_Record(SYS_TRACE_EVENT_ISR_ENTER, _DMA0_VECTOR);
+
     DMA0_InterruptHandler();
+
+    SYS_TRACE_Record(SYS_TRACE_EVENT_ISR_EXIT, _DMA0_VECTOR);
 }
 
 
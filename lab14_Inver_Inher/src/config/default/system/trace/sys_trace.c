@@ -0,0 +1,187 @@
+/*******************************************************************************
+  System Kernel Trace Service
+
+  File Name:
+    sys_trace.c
+
+  Summary:
+    Binary recorder for the FreeRTOS trace hooks.
+
+  Description:
+    The ring has one write index and one read index that only grow, their
+    difference is the number of stored records.  Writers run with the kernel
+    interrupts masked and only move the write index, the reader only moves
+    the read index, with a single store after it copied the records.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "device.h"
+#include "FreeRTOS.h"
+#include "sys_trace.h"
+
+#if (configUSE_TRACE_FACILITY != 1)
+    #error SYS_TRACE needs configUSE_TRACE_FACILITY for task and queue numbers
+#endif
+
+#if ((SYS_TRACE_BUFFER_RECORDS & (SYS_TRACE_BUFFER_RECORDS - 1U)) != 0U)
+    #error SYS_TRACE_BUFFER_RECORDS must be a power of two
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SYS_TRACE_RECORD sysTraceBuffer[SYS_TRACE_BUFFER_RECORDS];
+
+static volatile uint32_t sysTraceHead;
+static volatile uint32_t sysTraceTail;
+static volatile uint32_t sysTraceDropped;
+static volatile bool sysTraceEnabled;
+
+/* Number of the running task, written on every switch */
+static volatile uint8_t sysTraceTask;
+
+static uint16_t sysTraceQueueNumber;
+static uint16_t sysTraceSequence;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_TRACE_Initialize( void )
+{
+    UBaseType_t uxSavedStatus;
+
+    uxSavedStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    sysTraceHead = 0U;
+    sysTraceTail = 0U;
+    sysTraceDropped = 0U;
+    sysTraceSequence = 0U;
+    sysTraceEnabled = true;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedStatus);
+}
+
+void SYS_TRACE_Start( void )
+{
+    sysTraceEnabled = true;
+}
+
+void SYS_TRACE_Stop( void )
+{
+    sysTraceEnabled = false;
+}
+
+void SYS_TRACE_Record( uint8_t event, uint16_t arg )
+{
+    UBaseType_t uxSavedStatus;
+    SYS_TRACE_RECORD *record;
+    uint32_t head;
+
+    if (sysTraceEnabled == false)
+    {
+        return;
+    }
+
+    uxSavedStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    head = sysTraceHead;
+    if ((head - sysTraceTail) < SYS_TRACE_BUFFER_RECORDS)
+    {
+        record = &sysTraceBuffer[head & (SYS_TRACE_BUFFER_RECORDS - 1U)];
+        record->time = _CP0_GET_COUNT();
+        record->event = event;
+        record->task = sysTraceTask;
+        record->arg = arg;
+
+        sysTraceHead = head + 1U;
+    }
+    else
+    {
+        sysTraceDropped++;
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedStatus);
+}
+
+void SYS_TRACE_TaskSwitchedIn( uint32_t number, uint32_t priority )
+{
+    /* Called from vTaskSwitchContext, the kernel interrupts are masked or
+       the scheduler has not started yet */
+    sysTraceTask = (uint8_t)number;
+
+    SYS_TRACE_Record((uint8_t)SYS_TRACE_EVENT_TASK_SWITCHED_IN, (uint16_t)priority);
+}
+
+uint16_t SYS_TRACE_QueueNumberNext( void )
+{
+    UBaseType_t uxSavedStatus;
+    uint16_t number;
+
+    uxSavedStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    number = ++sysTraceQueueNumber;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedStatus);
+
+    return number;
+}
+
+size_t SYS_TRACE_FrameRead( void *buffer, size_t size )
+{
+    SYS_TRACE_FRAME_HEADER *header = (SYS_TRACE_FRAME_HEADER *)buffer;
+    SYS_TRACE_RECORD *records = (SYS_TRACE_RECORD *)(header + 1);
+    UBaseType_t uxSavedStatus;
+    uint32_t tail;
+    uint32_t count;
+    uint32_t room;
+    uint32_t i;
+
+    if (size < sizeof(SYS_TRACE_FRAME_HEADER))
+    {
+        return 0U;
+    }
+
+    room = (uint32_t)((size - sizeof(SYS_TRACE_FRAME_HEADER)) / sizeof(SYS_TRACE_RECORD));
+    if (room > 0xFFFFU)
+    {
+        room = 0xFFFFU;
+    }
+
+    /* Records up to the head read here are complete, a writer that comes
+       later adds behind them */
+    tail = sysTraceTail;
+    count = sysTraceHead - tail;
+    if (count > room)
+    {
+        count = room;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        records[i] = sysTraceBuffer[(tail + i) & (SYS_TRACE_BUFFER_RECORDS - 1U)];
+    }
+
+    /* The slots are free for the writers from here on */
+    sysTraceTail = tail + count;
+
+    uxSavedStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    header->dropped = sysTraceDropped;
+    sysTraceDropped = 0U;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedStatus);
+
+    header->magic = SYS_TRACE_FRAME_MAGIC;
+    header->sequence = sysTraceSequence++;
+    header->count = (uint16_t)count;
+    header->time = _CP0_GET_COUNT();
+
+    return sizeof(SYS_TRACE_FRAME_HEADER) + (count * sizeof(SYS_TRACE_RECORD));
+}
@@ -0,0 +1,231 @@
+/*******************************************************************************
+  System Kernel Trace Service
+
+  File Name:
+    sys_trace.h
+
+  Summary:
+    Binary recorder for the FreeRTOS trace hooks.
+
+  Description:
+    FreeRTOSConfig.h maps the kernel trace macros (task switch, ready list,
+    queue send / receive / block, mutex inheritance) onto SYS_TRACE_Record.
+    Each event is stored as an 8 byte record: the CP0 Count value (10 ns,
+    wraps every 43 s), the event, the number of the running task and one 16
+    bit argument.  No text is formatted on the target.
+
+    The records go into a RAM ring of SYS_TRACE_BUFFER_RECORDS entries.  When
+    the ring is full new events are dropped and counted, the records already
+    stored are never overwritten, so the reader needs no lock.
+    SYS_TRACE_FrameRead moves the oldest records out behind a frame header,
+    the application sends the frame wherever it likes (lab14 uses the UART6
+    DMA channel).
+
+    Tasks carry uxTCBNumber and queues a number given when they are created,
+    both need configUSE_TRACE_FACILITY.  The header only uses fixed width
+    types, FreeRTOSConfig.h includes it before the kernel types exist.
+*******************************************************************************/
+
+#ifndef SYS_TRACE_H
+#define SYS_TRACE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Records in the ring, a power of two.  8 bytes each. */
+#ifndef SYS_TRACE_BUFFER_RECORDS
+    #define SYS_TRACE_BUFFER_RECORDS    (512U)
+#endif
+
+/* Set to 1 to record every tick interrupt as well.  At 1 kHz this fills the
+   ring quickly, it is off by default. */
+#ifndef SYS_TRACE_TICKS
+    #define SYS_TRACE_TICKS             (0)
+#endif
+
+/* First word of a frame, "TRC1" in memory order */
+#define SYS_TRACE_FRAME_MAGIC           (0x31435254UL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Event codes, the meaning of arg is given for each one. */
+typedef enum
+{
+    /* arg = priority of the task now running, task = its number */
+    SYS_TRACE_EVENT_TASK_SWITCHED_IN = 1,
+    /* arg = number of the task moved to the ready list */
+    SYS_TRACE_EVENT_TASK_READY,
+    /* arg = 0 */
+    SYS_TRACE_EVENT_TASK_DELAY,
+    /* arg = ( holder number << 8 ) | priority it inherits */
+    SYS_TRACE_EVENT_PRIORITY_INHERIT,
+    /* arg = ( holder number << 8 ) | priority it returns to */
+    SYS_TRACE_EVENT_PRIORITY_DISINHERIT,
+
+    /* arg = queue number, for all the queue events */
+    SYS_TRACE_EVENT_QUEUE_CREATE,
+    SYS_TRACE_EVENT_MUTEX_CREATE,
+    SYS_TRACE_EVENT_QUEUE_SEND,
+    SYS_TRACE_EVENT_QUEUE_SEND_FAILED,
+    SYS_TRACE_EVENT_QUEUE_SEND_BLOCK,
+    SYS_TRACE_EVENT_QUEUE_RECEIVE,
+    SYS_TRACE_EVENT_QUEUE_RECEIVE_FAILED,
+    SYS_TRACE_EVENT_QUEUE_RECEIVE_BLOCK,
+    SYS_TRACE_EVENT_QUEUE_SEND_FROM_ISR,
+    SYS_TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR,
+
+    /* arg = interrupt vector number */
+    SYS_TRACE_EVENT_ISR_ENTER,
+    SYS_TRACE_EVENT_ISR_EXIT,
+    /* arg = 0, an interrupt ends with portYIELD */
+    SYS_TRACE_EVENT_ISR_YIELD,
+
+    /* arg = low 16 bits of the tick count */
+    SYS_TRACE_EVENT_TICK,
+
+    /* Application markers, arg is free */
+    SYS_TRACE_EVENT_USER
+
+} SYS_TRACE_EVENT;
+
+typedef struct
+{
+    /* CP0 Count */
+    uint32_t time;
+    uint8_t event;
+    /* Number of the task running when the event happened, also inside an
+       interrupt */
+    uint8_t task;
+    uint16_t arg;
+
+} SYS_TRACE_RECORD;
+
+typedef struct
+{
+    uint32_t magic;
+    /* Counts frames, a gap means a frame was lost on the way */
+    uint16_t sequence;
+    /* Records following the header */
+    uint16_t count;
+    /* Events dropped since the previous frame because the ring was full,
+       they are newer than every record stored at that time */
+    uint32_t dropped;
+    /* CP0 Count when the frame was read */
+    uint32_t time;
+
+} SYS_TRACE_FRAME_HEADER;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_TRACE_Initialize( void )
+
+  Summary:
+    Empties the ring and starts recording.
+
+  Description:
+    Queues are numbered whether recording or not, objects created before
+    this call keep their number.
+*/
+void SYS_TRACE_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_TRACE_Start( void )
+    void SYS_TRACE_Stop( void )
+
+  Summary:
+    Resume or pause recording, the ring keeps its content.
+*/
+void SYS_TRACE_Start( void );
+
+void SYS_TRACE_Stop( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_TRACE_Record( uint8_t event, uint16_t arg )
+
+  Summary:
+    Stores one event, callable from any context.
+
+  Description:
+    Interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY are masked for the
+    few instructions that claim the slot and fill it.  Handlers above that
+    priority must not call it.
+*/
+void SYS_TRACE_Record( uint8_t event, uint16_t arg );
+
+// *****************************************************************************
+/* Function:
+    void SYS_TRACE_TaskSwitchedIn( uint32_t number, uint32_t priority )
+
+  Summary:
+    traceTASK_SWITCHED_IN, remembers the running task for the next records.
+*/
+void SYS_TRACE_TaskSwitchedIn( uint32_t number, uint32_t priority );
+
+// *****************************************************************************
+/* Function:
+    uint16_t SYS_TRACE_QueueNumberNext( void )
+
+  Summary:
+    Number for a queue that is being created, traceQUEUE_CREATE stores it in
+    uxQueueNumber.
+*/
+uint16_t SYS_TRACE_QueueNumberNext( void );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_TRACE_FrameRead( void *buffer, size_t size )
+
+  Summary:
+    Moves the oldest records into a frame.
+
+  Description:
+    buffer, word aligned, receives a SYS_TRACE_FRAME_HEADER followed by as
+    many records as fit into size bytes and are stored.  Returns the length
+    of the frame, 0 when size cannot hold the header.  A frame with no
+    records still reports dropped events.  Task context, one reader at a
+    time.
+*/
+size_t SYS_TRACE_FrameRead( void *buffer, size_t size );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_TRACE_H
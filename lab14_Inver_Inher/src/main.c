@@ -19,6 +19,8 @@
  *		Static Tasks 
  *		configUSE_MUTEXES 1 : enable Priority Inheritance feature and enable xSemaphoreCreateMutex() macro
  *		uxTaskPriorityGet() built-in function
+ *		Kernel trace recorder (system/trace), dumped in binary frames on UART6 on demand
+ *		configUSE_MUTEX_PRIORITY_CEILING 1 : enable xSemaphoreCreateMutexWithCeiling(), the immediate priority ceiling mutex
 
   Summary:
     Priority Inversion: A higher-priority task is forced to wait because a lower-priority task holds a resource (like a mutex).
@@ -35,6 +37,13 @@ If a medium-priority task runs in between, the higher-priority task is delayed l
     This file contains the "main" function for a project.  The "main" function calls the "SYS_Initialize" function to initialize the state
     machines of all modules in the system. Debug messages are showed via UART6. 
  * DMA module is using to make the task/CPU unblock and transmission continues in background.
+ * The kernel trace hooks record every switch, mutex take/give/block and inheritance with a CP0 Count
+ * time stamp into a RAM ring, where the debugger can read them. Set LAB14_TRACE_TO_UART to 1 and the task Trace
+ * sends the ring once task Low ends the inversion, as binary frames starting with "TRC1" between the text lines.
+ * tools/trace_decode.py cuts the frames out of a capture and prints the timeline and the latency report.
+ * With LAB14_PRIORITY_CEILING set to 1 the mutex is a priority ceiling mutex: task Low runs at the priority
+ * of task High as soon as it takes the mutex, and task High waiting for it changes no priority.
+ * At start task Low times a take/give pair on both kinds of mutex, and task High prints how long it waited.
  *******************************************************************************/
 // *****************************************************************************
 // *****************************************************************************
@@ -51,6 +60,7 @@ If a medium-priority task runs in between, the higher-priority task is delayed l
 #include "task.h"
 #include "semphr.h"
 #include "device_cache.h"
+#include "system/trace/sys_trace.h"
 #include <string.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -65,6 +75,43 @@ static StackType_t xTaskLowTcbBuffer[configMINIMAL_STACK_SIZE];
 static void xTaskHighFunction (void * pvParams);//this task High will be blocked by the task Low
 static void xTaskLowFunction (void * pvParams);// this task Low will have different priority level because of Priority Inheritance feature
 
+//1: the task Trace sends the trace records on UART6 when asked, 0: they stay in RAM for the debugger
+#define LAB14_TRACE_TO_UART 0
+
+#if LAB14_TRACE_TO_UART
+//records per frame, a frame takes about 45 ms at 115200 baud
+#define TRACE_FRAME_RECORDS 64
+
+static StaticTask_t xTaskTraceBuffer;
+static StackType_t xTaskTraceTcbBuffer[configMINIMAL_STACK_SIZE];
+static TaskHandle_t xTaskTrace = NULL;
+static void xTaskTraceFunction (void * pvParams);//this task drains the trace ring when notified
+
+static uint8_t __attribute__ ((aligned (16))) u6TraceBuffer[sizeof(SYS_TRACE_FRAME_HEADER) + TRACE_FRAME_RECORDS * sizeof(SYS_TRACE_RECORD)];
+#endif
+
+//1: xMutex is a priority ceiling mutex, task Low is raised when it takes the mutex
+//0: xMutex is a priority inheritance mutex, task Low is raised when task High waits for it
+#define LAB14_PRIORITY_CEILING 0
+
+//the highest priority of the tasks taking xMutex, the one of task High
+#define MUTEX_CEILING_PRIORITY (tskIDLE_PRIORITY + 3)
+
+//take/give pairs timed on each kind of mutex, the fastest one is printed
+#define MUTEX_BENCH_ROUNDS 64
+
+//the core timer counts at half the CPU clock
+#define CORE_TIMER_CYCLES(count) ((count) * 2U)
+
+//mutexes only used for timing, one of each kind
+static StaticSemaphore_t xBenchInheritBuffer;
+static StaticSemaphore_t xBenchCeilingBuffer;
+static SemaphoreHandle_t xBenchInherit = NULL;
+static SemaphoreHandle_t xBenchCeiling = NULL;
+
+//the longest time task High waited for the mutex
+static TickType_t xHighWaitMax = 0;
+
 //activate_inheritance is set to 1 will show Priority Inheritance feature 
 //activate_inheritance is cleared to 0 will change priority level to original level
 static uint8_t activate_inheritance = 1;
@@ -95,6 +142,9 @@ static void Debug_msg(char * msg){
 }
 
 static void LAB14_Initialize(void){
+	//start recording before the primitives are created so they get a trace number
+	SYS_TRACE_Initialize();
+	
 	//register callback function of UART6 ISR
 	DMAC_ChannelCallbackRegister(
 				DMAC_CHANNEL_0,
@@ -102,8 +152,18 @@ static void LAB14_Initialize(void){
 				0);
 	
 	//create primitives
+#if LAB14_PRIORITY_CEILING
+	xMutex = xSemaphoreCreateMutexWithCeiling(MUTEX_CEILING_PRIORITY);
+#else
 	xMutex = xSemaphoreCreateMutex();
+#endif
 	xBinarySema = xSemaphoreCreateBinary();
+	xBenchInherit = xSemaphoreCreateMutexStatic(&xBenchInheritBuffer);
+	xBenchCeiling = xSemaphoreCreateMutexWithCeilingStatic(MUTEX_CEILING_PRIORITY, &xBenchCeilingBuffer);
+	if ((xBenchInherit == NULL) || (xBenchCeiling == NULL)){
+		Debug_msg("cannot create the benchmark mutexes \r\n");
+		exit(EXIT_FAILURE);
+	}
 	
 	//create task High - statically
 	if (xTaskCreateStatic(
@@ -131,6 +191,21 @@ static void LAB14_Initialize(void){
 		exit(EXIT_FAILURE);
 	}
 	
+#if LAB14_TRACE_TO_UART
+	//create task Trace - statically, above task Low and below task High
+	xTaskTrace = xTaskCreateStatic(
+			xTaskTraceFunction,
+			"the task Trace",
+			configMINIMAL_STACK_SIZE,
+			NULL,
+			tskIDLE_PRIORITY+1,
+			xTaskTraceTcbBuffer,
+			&xTaskTraceBuffer);
+	if (xTaskTrace == NULL){
+		Debug_msg("cannot create task Trace \r\n");
+		exit(EXIT_FAILURE);
+	}
+#endif
 }
 
 // *****************************************************************************
@@ -165,6 +240,21 @@ int main ( void )
     return ( EXIT_FAILURE );
 }
 
+//the fastest uncontended take/give pair in CPU cycles
+static uint32_t prvMutexBench(SemaphoreHandle_t xBenchMutex){
+	uint32_t best = UINT32_MAX;
+	for (uint32_t round = 0; round < MUTEX_BENCH_ROUNDS; round++){
+		uint32_t start = _CP0_GET_COUNT();
+		xSemaphoreTake(xBenchMutex, 0);
+		xSemaphoreGive(xBenchMutex);
+		uint32_t count = _CP0_GET_COUNT() - start;
+		if (count < best){
+			best = count;
+		}
+	}
+	return CORE_TIMER_CYCLES(best);
+}
+
 static void xTaskHighFunction (void * pvParams){
 	(void)pvParams;
 
@@ -173,8 +263,14 @@ static void xTaskHighFunction (void * pvParams){
 		//simulate that task High is yielding 
 		vTaskDelay(pdMS_TO_TICKS(1000));
 		//task High is blocking because of waiting for the mutex
+		TickType_t xWaitStart = xTaskGetTickCount();
 		if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-			sprintf((char *)u6TxBuffer, "Hello it's OK now, Task High is taking Mutex and running ..\r\n");
+			TickType_t xWait = xTaskGetTickCount() - xWaitStart;
+			if (xWait > xHighWaitMax){
+				xHighWaitMax = xWait;
+			}
+			sprintf((char *)u6TxBuffer, "Hello it's OK now, Task High is taking Mutex after %lu ms (max %lu ms) ..\r\n",
+					(unsigned long)pdTICKS_TO_MS(xWait), (unsigned long)pdTICKS_TO_MS(xHighWaitMax));
 			DCACHE_CLEAN_BY_ADDR(
 						(uint32_t)u6TxBuffer,
 						strlen((const char *)u6TxBuffer));
@@ -192,6 +288,25 @@ static void xTaskHighFunction (void * pvParams){
 
 static void xTaskLowFunction(void * pvParams){
 	(void)pvParams;
+
+	//task Low has the lowest priority, so the ceiling mutex has to raise it on every take
+	uint32_t inheritCycles = prvMutexBench(xBenchInherit);
+	uint32_t ceilingCycles = prvMutexBench(xBenchCeiling);
+	if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
+		sprintf((char *)u6TxBuffer, "take/give inheritance mutex %lu cycles, ceiling mutex %lu cycles \r\n",
+				(unsigned long)inheritCycles, (unsigned long)ceilingCycles);
+		DCACHE_CLEAN_BY_ADDR(
+					(uint32_t)u6TxBuffer,
+					strlen((const char *)u6TxBuffer));
+		DMAC_ChannelTransfer(
+				DMAC_CHANNEL_0,
+				(const void *)u6TxBuffer,
+				strlen((const char *)u6TxBuffer),
+				(const void *)&U6TXREG, 1, 1);
+		xSemaphoreTake(xBinarySema, portMAX_DELAY);
+		xSemaphoreGive(xMutex);
+	}
+
 	for (;;){// this loop is for mainstream
 		if (activate_inheritance ==1 ){
 		//task Low takes the mutex and doesn't give. 
@@ -216,11 +331,19 @@ static void xTaskLowFunction(void * pvParams){
 				}
 				activate_inheritance = 0;//deactivate the situation
 				xSemaphoreGive(xMutex);
+#if LAB14_TRACE_TO_UART
+				//the inversion is over, ask the task Trace for the records of it
+				xTaskNotifyGive(xTaskTrace);
+#endif
 			}
 		} else {
 			for (;;){ //this loop is for sub-stream
 				if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
+#if LAB14_PRIORITY_CEILING
+					sprintf((char *)u6TxBuffer, "phusss OK now, task Low is taking mutex and runs at the ceiling %lu \r\n", uxTaskPriorityGet(NULL));
+#else
 					sprintf((char *)u6TxBuffer, "phusss OK now, task Low is taking mutex and  priority is  back to %lu \r\n", uxTaskPriorityGet(NULL));
+#endif
 					DCACHE_CLEAN_BY_ADDR(
 								(uint32_t)u6TxBuffer,
 								strlen((const char *)u6TxBuffer));
@@ -239,6 +362,34 @@ static void xTaskLowFunction(void * pvParams){
 	}
 }
 
+#if LAB14_TRACE_TO_UART
+static void xTaskTraceFunction(void * pvParams){
+	size_t length;
+	(void)pvParams;
+
+	for(;;){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		//the mutex owns UART6 and DMA channel 0, a frame never cuts a text line
+		if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
+			//send frames until the ring is empty, an empty frame still reports dropped records
+			do {
+				length = SYS_TRACE_FrameRead(u6TraceBuffer, sizeof(u6TraceBuffer));
+				DCACHE_CLEAN_BY_ADDR(
+							(uint32_t)u6TraceBuffer,
+							length);
+				DMAC_ChannelTransfer(
+						DMAC_CHANNEL_0,
+						(const void *)u6TraceBuffer,
+						length,
+						(const void *)&U6TXREG, 1, 1);
+				xSemaphoreTake(xBinarySema, portMAX_DELAY);
+			} while (((SYS_TRACE_FRAME_HEADER *)u6TraceBuffer)->count == TRACE_FRAME_RECORDS);
+			xSemaphoreGive(xMutex);
+		}
+	}
+}
+#endif
+
 /*******************************************************************************
  End of File
 */
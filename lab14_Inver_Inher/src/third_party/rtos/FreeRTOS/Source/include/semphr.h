@@ -798,6 +798,58 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+ *                                                           StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead of
+ * priority inheritance.  configUSE_MUTEX_PRIORITY_CEILING must be set to 1.
+ *
+ * A task that takes the mutex runs at uxCeilingPriority, or its own priority
+ * if that is higher, until it gives back the last mutex it holds.  No task
+ * that uses the mutex can then preempt the holder, so the holder is never
+ * found holding the mutex by another task that wants it, unless the holder
+ * blocks while holding it.  A task that blocks on the mutex does not change
+ * the priority of the holder.
+ *
+ * uxCeilingPriority must be at least the priority of every task that takes the
+ * mutex, and below configMAX_PRIORITIES.
+ *
+ * The mutex is used with xSemaphoreTake() and xSemaphoreGive() as a mutex
+ * created with xSemaphoreCreateMutex(), and cannot be used from interrupts.
+ *
+ * @param uxCeilingPriority The priority the holder of the mutex runs at.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return A handle to the created mutex, or NULL if it could not be created.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // Every task that uses the mutex has priority 3 or lower.
+ *  xSemaphore = xSemaphoreCreateMutexWithCeiling( 3 );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
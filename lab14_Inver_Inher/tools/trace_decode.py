@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""Decode the kernel trace frames (system/trace) of lab 14.
+
+The task Trace sends the trace ring as binary frames between the text lines
+of the console.  Each frame is a SYS_TRACE_FRAME_HEADER followed by `count`
+SYS_TRACE_RECORD entries, all little endian:
+
+    header  "TRC1", sequence (16), count (16), dropped (32), time (32)
+    record  time (32, CP0 Count), event (8), task number (8), arg (16)
+
+The event names are read from the SYS_TRACE_EVENT enum of sys_trace.h.  The
+decoder prints the timeline of every record and a latency report:
+
+    mutex waits      QUEUE_RECEIVE_BLOCK on a mutex to the task's next take
+    inheritance      PRIORITY_INHERIT to PRIORITY_DISINHERIT of the holder
+    ready to run     TASK_READY to TASK_SWITCHED_IN of the same task
+    interrupts       ISR_ENTER to ISR_EXIT of the same vector
+    cpu time         time between a task switching in and the next switch
+
+Tasks are known by their number (uxTCBNumber), given in creation order.
+Name them with --task, e.g. --task 1=High --task 2=Low.
+
+Usage:
+    python3 trace_decode.py capture.bin
+    python3 trace_decode.py --report-only capture.bin
+    cat /dev/ttyACM0 > capture.bin       (115200 baud, 8N1)
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+from collections import defaultdict
+
+MAGIC = b"TRC1"
+HEADER = struct.Struct("<4sHHII")
+RECORD = struct.Struct("<IBBH")
+
+# CP0 Count runs at SYSCLK / 2, 10 ns per count at 200 MHz
+COUNT_NS = 10
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src",
+                              "config", "default", "system", "trace", "sys_trace.h")
+
+# Task numbers of lab14 in creation order, the idle and timer tasks follow.
+# 0 is before the scheduler started.
+DEFAULT_TASKS = {0: "(init)", 1: "High", 2: "Low", 3: "Trace"}
+
+
+def load_events(path):
+    with open(path, encoding="utf-8", errors="replace") as header:
+        text = header.read()
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", " ", text)
+    match = re.search(r"typedef\s+enum\s*\{(.*?)\}\s*SYS_TRACE_EVENT\s*;", text, flags=re.S)
+    if match is None:
+        raise SystemExit("no SYS_TRACE_EVENT in %s" % path)
+    events = {}
+    value = -1
+    for entry in match.group(1).split(","):
+        name, _, expr = entry.strip().partition("=")
+        name = name.strip()
+        if not name:
+            continue
+        value = int(expr.strip(), 0) if expr.strip() else value + 1
+        events[value] = name.replace("SYS_TRACE_EVENT_", "")
+    return events
+
+
+def read_frames(data):
+    """Yields (header, records) for each complete frame, text is skipped."""
+    pos = 0
+    while True:
+        pos = data.find(MAGIC, pos)
+        if pos < 0 or pos + HEADER.size > len(data):
+            return
+        _, sequence, count, dropped, time = HEADER.unpack_from(data, pos)
+        end = pos + HEADER.size + count * RECORD.size
+        if end > len(data):
+            return
+        records = [RECORD.unpack_from(data, pos + HEADER.size + i * RECORD.size) for i in range(count)]
+        yield (sequence, count, dropped, time), records
+        pos = end
+
+
+class Clock:
+    """Extends the 32 bit CP0 Count, assuming no gap of 43 s between records."""
+
+    def __init__(self):
+        self.last = None
+        self.high = 0
+        self.origin = None
+
+    def ns(self, count):
+        if self.last is not None and count < self.last:
+            self.high += 1 << 32
+        self.last = count
+        value = self.high + count
+        if self.origin is None:
+            self.origin = value
+        return (value - self.origin) * COUNT_NS
+
+
+class Stats:
+    def __init__(self):
+        self.samples = defaultdict(list)
+
+    def add(self, key, ns):
+        self.samples[key].append(ns)
+
+    def print(self, title, out):
+        if not self.samples:
+            return
+        out.write("\n%s\n" % title)
+        out.write("  %-28s %6s %12s %12s %12s\n" % ("", "count", "min us", "mean us", "max us"))
+        for key in sorted(self.samples):
+            values = self.samples[key]
+            out.write("  %-28s %6u %12.3f %12.3f %12.3f\n" % (
+                key, len(values), min(values) / 1000.0, sum(values) / len(values) / 1000.0, max(values) / 1000.0))
+
+
+def decode(data, events, tasks, timeline, out):
+    def task_name(number):
+        return tasks.get(number, "task %u" % number)
+
+    clock = Clock()
+    mutexes = set()
+    waits = Stats()
+    inherit = Stats()
+    ready = Stats()
+    isr = Stats()
+    cpu = defaultdict(int)
+
+    blocked = {}        # (task, queue) -> start of the wait
+    inherited = {}      # holder -> start of the raised priority
+    readied = {}        # task -> time it was made ready
+    isr_start = {}      # vector -> entry time
+    running = None      # (task, switched in at)
+    expected = None
+    frames = 0
+    dropped_total = 0
+    last_ns = 0
+
+    for (sequence, count, dropped, _), records in read_frames(data):
+        frames += 1
+        if expected is not None and sequence != expected:
+            out.write("# frames %u..%u lost\n" % (expected, (sequence - 1) & 0xFFFF))
+        expected = (sequence + 1) & 0xFFFF
+        if dropped:
+            dropped_total += dropped
+            out.write("# frame %u: %u events dropped on the target, the ring was full\n" % (sequence, dropped))
+
+        for time, event, task, arg in records:
+            ns = clock.ns(time)
+            last_ns = ns
+            name = events.get(event, "EVENT_%u" % event)
+
+            if name == "MUTEX_CREATE":
+                mutexes.add(arg)
+            elif name == "TASK_SWITCHED_IN":
+                if running is not None:
+                    cpu[running[0]] += ns - running[1]
+                running = (task, ns)
+                if task in readied:
+                    ready.add(task_name(task), ns - readied.pop(task))
+            elif name == "TASK_READY":
+                readied.setdefault(arg, ns)
+            elif name == "QUEUE_RECEIVE_BLOCK" and arg in mutexes:
+                blocked.setdefault((task, arg), ns)
+            elif name == "QUEUE_RECEIVE" and (task, arg) in blocked:
+                waits.add("%s on mutex %u" % (task_name(task), arg), ns - blocked.pop((task, arg)))
+            elif name == "PRIORITY_INHERIT":
+                inherited.setdefault(arg >> 8, ns)
+            elif name == "PRIORITY_DISINHERIT" and (arg >> 8) in inherited:
+                inherit.add("%s raised" % task_name(arg >> 8), ns - inherited.pop(arg >> 8))
+            elif name == "ISR_ENTER":
+                isr_start[arg] = ns
+            elif name == "ISR_EXIT" and arg in isr_start:
+                isr.add("vector %u" % arg, ns - isr_start.pop(arg))
+
+            if timeline:
+                out.write("%14.3f us  %-10s %-22s %s\n" % (
+                    ns / 1000.0, task_name(task), name, describe(name, arg, mutexes, task_name)))
+
+    if running is not None:
+        cpu[running[0]] += last_ns - running[1]
+
+    out.write("\n%u frames, %u events dropped on the target, %.3f ms traced\n" % (
+        frames, dropped_total, last_ns / 1e6))
+    waits.print("mutex waits", out)
+    inherit.print("priority inheritance", out)
+    ready.print("ready to running", out)
+    isr.print("interrupts", out)
+    if cpu and last_ns:
+        out.write("\ncpu time\n")
+        for task in sorted(cpu):
+            out.write("  %-28s %12.3f us %6.1f %%\n" % (task_name(task), cpu[task] / 1000.0, 100.0 * cpu[task] / last_ns))
+
+
+def describe(name, arg, mutexes, task_name):
+    if name == "TASK_SWITCHED_IN":
+        return "priority %u" % arg
+    if name == "TASK_READY":
+        return task_name(arg)
+    if name in ("PRIORITY_INHERIT", "PRIORITY_DISINHERIT"):
+        return "%s to priority %u" % (task_name(arg >> 8), arg & 0xFF)
+    if name.startswith("QUEUE_") or name == "MUTEX_CREATE":
+        return ("mutex %u" if arg in mutexes else "queue %u") % arg
+    if name.startswith("ISR_ENTER") or name.startswith("ISR_EXIT"):
+        return "vector %u" % arg
+    if name in ("TASK_DELAY", "ISR_YIELD"):
+        return ""
+    return "%u" % arg
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode lab14 kernel trace frames.")
+    parser.add_argument("capture", help="captured console output, - for stdin")
+    parser.add_argument("--header", default=DEFAULT_HEADER, help="sys_trace.h with the event enum")
+    parser.add_argument("--task", action="append", default=[], metavar="N=NAME", help="name a task number")
+    parser.add_argument("--report-only", action="store_true", help="skip the timeline")
+    options = parser.parse_args()
+
+    tasks = dict(DEFAULT_TASKS)
+    for entry in options.task:
+        number, _, name = entry.partition("=")
+        tasks[int(number, 0)] = name
+
+    if options.capture == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(options.capture, "rb") as capture:
+            data = capture.read()
+
+    decode(data, load_events(options.header), tasks, not options.report_only, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
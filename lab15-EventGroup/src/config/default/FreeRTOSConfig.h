@@ -225,6 +225,13 @@
 
 #define configUSE_EVENT_GROUPS    1
 
+/* Set configUSE_EVENT_GROUP_DIRECT_ISR to 1 to have xEventGroupSetBitsFromISR()
+ * and xEventGroupClearBitsFromISR() update the event group and unblock the
+ * waiting tasks inside the interrupt, instead of deferring the work to the
+ * timer task.  Defaults to 0 if left undefined. */
+
+#define configUSE_EVENT_GROUP_DIRECT_ISR    1
+
 /******************************************************************************/
 /* Stream Buffer related definitions. *****************************************/
 /******************************************************************************/
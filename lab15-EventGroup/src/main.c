@@ -100,6 +100,11 @@ static void prvBlinkingRedFunction(TimerHandle_t xTimer);
 static EventGroupHandle_t xEveGr;
 static StaticEventGroup_t xEveGrBuffer;
 
+//core timer count when the DMA complete interrupt set BIT_UART6_COMPLETE, the core timer runs at half the cpu clock
+//with configUSE_EVENT_GROUP_DIRECT_ISR 0 the wake up goes through the timer task, set it to compare both paths
+static volatile uint32_t ulUart6CompleteCount;
+#define CORE_TIMER_NS(count)	((uint32_t)(((uint64_t)(count) * 2000000000U) / CPU_CLOCK_FREQUENCY))
+
 //declare callbak for ISR of key press
 static void SW1_ISR_Callback(GPIO_PIN pin, uintptr_t context){
 	if (SW1_Get() == KEY_PRESS_STATE){
@@ -113,6 +118,7 @@ static void SW1_ISR_Callback(GPIO_PIN pin, uintptr_t context){
 static void U6D0Callback(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
 	if (event == DMAC_TRANSFER_EVENT_COMPLETE){
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		ulUart6CompleteCount = _CP0_GET_COUNT();
 		xEventGroupSetBitsFromISR(xEveGr, BIT_UART6_COMPLETE, &xHigherPriorityTaskWoken );
 		portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 	}
@@ -256,6 +262,26 @@ static void prvBlinkingRedFunction(TimerHandle_t xTimer){
 	LED1_Toggle();
 }
 
+//send the text in u6TxBuffer by DMA and wait for BIT_UART6_COMPLETE, the caller holds xMutex
+//returns the core timer counts from the DMA complete interrupt to the task waking up
+static uint32_t prvU6Send(void){
+	DCACHE_CLEAN_BY_ADDR(
+		(uint32_t) u6TxBuffer,
+		strlen((const char *) u6TxBuffer));
+	DMAC_ChannelTransfer(
+		DMAC_CHANNEL_0,
+		(const void *) u6TxBuffer,
+		strlen((const char *)u6TxBuffer),
+		(const void *)&U6TXREG, 1, 1);
+	xEventGroupWaitBits( //waiting for BIT_UART6_COMPLETE for transfer event complete
+		xEveGr,
+		BIT_UART6_COMPLETE,
+		pdTRUE,
+		pdFALSE,
+		portMAX_DELAY); 
+	return _CP0_GET_COUNT() - ulUart6CompleteCount;
+}
+
 //a task function to show message on com port
 static void prvTaskRedFunction(void * Params){
 	(void ) Params;
@@ -271,20 +297,12 @@ static void prvTaskRedFunction(void * Params){
 			{
 				sprintf((char *)u6TxBuffer, "  Mayday Mayday RED blinking period %d ms\r\n", 
 						red_interval[red_count & (RED_INDEX-1)]);
-				DCACHE_CLEAN_BY_ADDR(
-					(uint32_t) u6TxBuffer,
-					strlen((const char *) u6TxBuffer));
-				DMAC_ChannelTransfer(
-					DMAC_CHANNEL_0,
-					(const void *) u6TxBuffer,
-					strlen((const char *)u6TxBuffer),
-					(const void *)&U6TXREG, 1, 1);
-				xEventGroupWaitBits( //waiting for BIT_UART6_COMPLETE for transfer event complete
-					xEveGr,
-					BIT_UART6_COMPLETE,
-					pdTRUE,
-					pdFALSE,
-					portMAX_DELAY); 
+				uint32_t ulWakeCount = prvU6Send();
+				
+				//show how long the task took to wake up after the transfer completed
+				//the measurement is over, the line goes out by DMA like the one before
+				sprintf((char *)u6TxBuffer, "  DMA complete to task wake up %lu ns\r\n", (unsigned long)CORE_TIMER_NS(ulWakeCount));
+				(void)prvU6Send();
 
 				xSemaphoreGive(xMutex);
 			}			
@@ -77,7 +77,9 @@
 /* Set configUSE_TICKLESS_IDLE to 1 to use the low power tickless mode.  Set to
  * 0 to keep the tick interrupt running at all times.  Not all FreeRTOS ports
  * support tickless mode. See https://www.freertos.org/low-power-tickless-rtos.html
- * Defaults to 0 if left undefined. */
+ * Defaults to 0 if left undefined.  The PIC32MZ port has a tickless path
+ * (vPortSuppressTicksAndSleep), but it has not been built with XC32 nor run on
+ * the board yet, so it is left off in every lab until it has. */
 #define configUSE_TICKLESS_IDLE                 0
 
 /* configMAX_PRIORITIES Sets the number of available task priorities.  Tasks can
@@ -117,11 +119,18 @@
  * if left undefined. */
 #define configIDLE_SHOULD_YIELD                 1
 
+/* Set configUSE_DELAYED_TASK_HEAP to 1 to order blocked tasks by wake time in a
+ * binary heap instead of sorted lists, so blocking with a timeout costs
+ * O(log n) in the number of blocked tasks.  configDELAYED_TASK_HEAP_LENGTH must
+ * be at least the number of tasks, including the idle and timer tasks. */
+#define configUSE_DELAYED_TASK_HEAP             1
+#define configDELAYED_TASK_HEAP_LENGTH          16
+
 /* Each task has an array of task notifications.
  * configTASK_NOTIFICATION_ARRAY_ENTRIES sets the number of indexes in the array.
  * See https://www.freertos.org/RTOS-task-notifications.html  Defaults to 1 if
  * left undefined. */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES      1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES      2
 
 /* configQUEUE_REGISTRY_SIZE sets the maximum number of queues and semaphores
  * that can be referenced from the queue registry.  Only required when using a
@@ -214,6 +223,17 @@
  * if configUSE_TIMERS is set to 1. */
 #define configTIMER_QUEUE_LENGTH                20
 
+/* Set configUSE_TIMER_WHEEL to 1 to keep active timers in a hierarchical timing
+ * wheel instead of sorted lists, so starting, resetting and stopping a timer
+ * does not depend on the number of active timers.  Every debounce bounce of the
+ * buttons resets a timer from the ISR.  The wheel has configTIMER_WHEEL_LEVELS
+ * levels of 2^configTIMER_WHEEL_SLOT_BITS slots. */
+#define configUSE_TIMER_WHEEL                   1
+
+/* configTIMER_COMMAND_BATCH sets how many commands the timer task takes from
+ * its queue in one critical section.  Needs configUSE_QUEUE_MULTIPLE. */
+#define configTIMER_COMMAND_BATCH               4
+
 /******************************************************************************/
 /* Event Group related definitions. *******************************************/
 /******************************************************************************/
@@ -308,7 +328,7 @@
  * functionality in the build.  Set to 0 to exclude the hook functionality from the
  * build.  The application writer is responsible for providing the hook function
  * for any set to 1.  See https://www.freertos.org/a00016.html. */
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_IDLE_HOOK                     1
 #define configUSE_TICK_HOOK                     0
 #define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
@@ -342,13 +362,13 @@
  * processing time used by each task.  Set to 0 to not collect the data.  The
  * application writer needs to provide a clock source if set to 1.  Defaults to 0
  * if left undefined.  See https://www.freertos.org/rtos-run-time-stats.html. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 
 /* Set configUSE_TRACE_FACILITY to include additional task structure members
  * are used by trace and visualisation functions and tools.  Set to 0 to exclude
  * the additional information from the structures. Defaults to 0 if left
  * undefined. */
-#define configUSE_TRACE_FACILITY                0
+#define configUSE_TRACE_FACILITY                1
 
 /* Set to 1 to include the vTaskList() and vTaskGetRunTimeStats() functions in
  * the build.  Set to 0 to exclude these functions from the build.  These two
@@ -357,6 +377,17 @@
  * undefined. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
+/* The run time clock is the CP0 Count register (SYSCLK / 2 = 100 MHz)
+ * extended to 64 bits by system/rtstats, a 32 bit counter would wrap every
+ * 43 seconds. */
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#ifndef __LANGUAGE_ASSEMBLY
+    void SYS_RTSTATS_Initialize( void );
+    uint64_t SYS_RTSTATS_CounterGet( void );
+    #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    SYS_RTSTATS_Initialize()
+    #define portGET_RUN_TIME_COUNTER_VALUE()            SYS_RTSTATS_CounterGet()
+#endif
+
 /******************************************************************************/
 /* Co-routine related definitions. ********************************************/
 /******************************************************************************/
@@ -372,6 +403,18 @@
  * priority. Defaults to 0 if left undefined. */
 #define configMAX_CO_ROUTINE_PRIORITIES         2
 
+/******************************************************************************/
+/* Debugging assistance. ******************************************************/
+/******************************************************************************/
+
+/* configASSERT() has the same semantics as the standard C assert().  A failed
+ * assertion is reported on the console by vAssertCalled() in freertos_hooks.c. */
+/* Prevent C specific syntax being included in assembly files. */
+#ifndef __LANGUAGE_ASSEMBLY
+    void vAssertCalled( const char *pcFileName, unsigned long ulLine );
+    #define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+#endif
+
 
 /******************************************************************************/
 /* Definitions that include or exclude functionality. *************************/
@@ -384,6 +427,7 @@
 #define configUSE_RECURSIVE_MUTEXES             0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_QUEUE_SETS                    0
+#define configUSE_QUEUE_MULTIPLE                1
 #define configUSE_APPLICATION_TASK_TAG          0
 #define configUSE_TASK_FPU_SUPPORT              0
 
@@ -400,10 +444,10 @@
 #define INCLUDE_xResumeFromISR                  1
 #define INCLUDE_vTaskDelayUntil                 1
 #define INCLUDE_vTaskDelay                      1
-#define INCLUDE_xTaskGetSchedulerState          0
+#define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
 #define INCLUDE_uxTaskGetStackHighWaterMark     1
-#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
 #define INCLUDE_xTimerPendFunctionCall          1
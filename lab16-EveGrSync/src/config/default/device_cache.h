@@ -75,8 +75,10 @@ extern "C" {
 
 #define DCACHE_ENABLE()
 #define DCACHE_DISABLE()
-#define DCACHE_CLEAN()
-#define DCACHE_CLEAN_INVALIDATE()
+/* The plib has no write back only operation: the whole cache and the
+   _BY_ADDR clean variants all write back and invalidate. */
+#define DCACHE_CLEAN()                                 CACHE_DataCacheFlush()
+#define DCACHE_CLEAN_INVALIDATE()                      CACHE_DataCacheFlush()
 #define DCACHE_INVALIDATE()                            CACHE_DataCacheFlush()
 #define DCACHE_CLEAN_BY_ADDR(addr,sz)                  CACHE_DataCacheClean(addr,sz)
 #define DCACHE_INVALIDATE_BY_ADDR(addr,sz)             CACHE_DataCacheInvalidate(addr,sz)
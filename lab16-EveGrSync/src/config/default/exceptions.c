@@ -47,6 +47,7 @@
 // *****************************************************************************
 #include "device.h"
 #include "definitions.h"
+#include "system/console/sys_console.h"
 #include <stdio.h>
 
 // *****************************************************************************
@@ -122,6 +123,14 @@ void __attribute__((noreturn, weak)) _general_exception_handler ( void )
     exception_code = ((_CP0_GET_CAUSE() & 0x0000007CU) >> 2U);
     exception_address = _CP0_GET_EPC();
 
+    SYS_CONSOLE_PanicEnter();
+    SYS_CONSOLE_Print("\r\nEXCEPTION ");
+    SYS_CONSOLE_PrintDec(exception_code);
+    SYS_CONSOLE_Print(" at ");
+    SYS_CONSOLE_PrintHex(exception_address);
+    SYS_CONSOLE_Print("\r\n");
+    SYS_CONSOLE_Flush();
+
     while (true)
     {
         #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
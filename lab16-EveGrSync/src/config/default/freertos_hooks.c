@@ -38,6 +38,8 @@
 // DOM-IGNORE-END
 #include "FreeRTOS.h"
 #include "task.h"
+#include "system/console/sys_console.h"
+#include "system/rtstats/sys_rtstats.h"
 
 
 void vApplicationIdleHook( void );
@@ -134,7 +136,10 @@ void vApplicationIdleHook( void )
     important that vApplicationIdleHook() is permitted to return to its calling
     function, because it is the responsibility of the idle task to clean up
     memory allocated by the kernel to any task that has since been deleted. */
-    
+
+    /* The idle task may run alone for longer than the 43 s wrap of the core
+    timer, read it so the 64 bit run time counter sees every wrap. */
+    (void)SYS_RTSTATS_CounterGet();
 }
 
 /*-----------------------------------------------------------*/
@@ -160,8 +165,15 @@ void vAssertCalled( const char * pcFile, unsigned long ulLine )
 {
    volatile unsigned long ul = 0;
 
-   ( void ) pcFile;
-   ( void ) ulLine;
+   /* Report synchronously, the log service and the scheduler can no longer
+      be trusted.  Interrupts stay masked from here on. */
+   SYS_CONSOLE_PanicEnter();
+   SYS_CONSOLE_Print("\r\nASSERT ");
+   SYS_CONSOLE_Print(pcFile);
+   SYS_CONSOLE_Print(":");
+   SYS_CONSOLE_PrintDec((uint32_t)ulLine);
+   SYS_CONSOLE_Print("\r\n");
+   SYS_CONSOLE_Flush();
 
    taskENTER_CRITICAL();
    {
@@ -50,6 +50,7 @@
 // *****************************************************************************
 #include "interrupts.h"
 #include "definitions.h"
+#include "system/rtstats/sys_rtstats.h"
 
 
 
@@ -69,6 +70,9 @@
 void CHANGE_NOTICE_C_Handler (void);
 void CHANGE_NOTICE_J_Handler (void);
 void DMA0_Handler (void);
+void DMA1_Handler (void);
+void DMA2_Handler (void);
+void DMA3_Handler (void);
 
 
 // *****************************************************************************
@@ -80,17 +84,56 @@ void DMA0_Handler (void);
 
 void __attribute__((used)) CHANGE_NOTICE_C_Handler (void)
 {
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
     CHANGE_NOTICE_C_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_CHANGE_NOTICE_C, start);
 }
 
 void __attribute__((used)) CHANGE_NOTICE_J_Handler (void)
 {
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
     CHANGE_NOTICE_J_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_CHANGE_NOTICE_J, start);
 }
 
 void __attribute__((used)) DMA0_Handler (void)
 {
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
     DMA0_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_DMA0, start);
+}
+
+void __attribute__((used)) DMA1_Handler (void)
+{
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
+    DMA1_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_DMA1, start);
+}
+
+void __attribute__((used)) DMA2_Handler (void)
+{
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
+    DMA2_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_DMA2, start);
+}
+
+void __attribute__((used)) DMA3_Handler (void)
+{
+    uint32_t start = SYS_RTSTATS_IsrEnter();
+
+    DMA3_InterruptHandler();
+
+    SYS_RTSTATS_IsrExit(SYS_RTSTATS_ISR_DMA3, start);
 }
 
 
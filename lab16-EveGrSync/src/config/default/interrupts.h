@@ -59,6 +59,9 @@
 void CHANGE_NOTICE_C_InterruptHandler( void );
 void CHANGE_NOTICE_J_InterruptHandler( void );
 void DMA0_InterruptHandler( void );
+void DMA1_InterruptHandler( void );
+void DMA2_InterruptHandler( void );
+void DMA3_InterruptHandler( void );
 
 
 
@@ -188,6 +188,61 @@ static void DMAC_ChannelSetAddresses( DMAC_CHANNEL channel, const void *srcAddr,
     *(volatile uint32_t *)(regs) = destAddress;
 }
 
+// *****************************************************************************
+/* Function:
+   static void DMAC_ChannelDescriptorLoad
+
+  Summary:
+    Programs one descriptor into a channel and starts it
+
+  Description:
+    Writes DCHxSSA, DCHxDSA, DCHxSSIZ, DCHxDSIZ and DCHxCSIZ, enables the
+    channel and forces the first cell when the channel is not started by an
+    interrupt.  The caller owns the channel and has cleared its flags.
+
+  Parameters:
+    DMAC_CHANNEL channel - DMA channel this function call pertains to
+    const DMAC_DESCRIPTOR *descriptor - block to transfer
+
+  Returns:
+    void
+*/
+static void DMAC_ChannelDescriptorLoad( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptor)
+{
+    volatile uint32_t *regs;
+
+    /* Set the source / destination addresses, DCHxSSA and DCHxDSA */
+    DMAC_ChannelSetAddresses(channel, descriptor->srcAddr, descriptor->destAddr);
+
+    /* Set the source size, DCHxSSIZ */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x50U);
+    *(volatile uint32_t *)(regs) = descriptor->srcSize;
+
+    /* Set the destination size, DCHxDSIZ */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x60U);
+    *(volatile uint32_t *)(regs) = descriptor->destSize;
+
+    /* Set the cell size, DCHxCSIZ */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x90U);
+    *(volatile uint32_t *)(regs) = descriptor->cellSize;
+
+    /* Enable the channel */
+    /* CHEN = 1 */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x0U)+2U;
+    *(volatile uint32_t *)(regs) = _DCH0CON_CHEN_MASK;
+
+    /* Check Channel Start IRQ Enable bit - SIRQEN */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x10U);
+
+    /* Initiate transfer if user did not set up channel for interrupt-initiated transfer. */
+    if((*(volatile uint32_t *)(regs) & _DCH1ECON_SIRQEN_MASK) == 0U)
+    {
+        /* CFORCE = 1 */
+        regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x10U)+2U;
+        *(volatile uint32_t *)(regs) = _DCH0ECON_CFORCE_MASK;
+    }
+}
+
 // *****************************************************************************
 /* Function:
    static uint32_t DMAC_BitReverse( uint32_t num, uint32_t bits)
@@ -267,6 +322,8 @@ void DMAC_Initialize( void )
         chanObj->pEventCallBack =    NULL;
         chanObj->hClientArg     =    0;
         chanObj->errorInfo      =    DMAC_ERROR_NONE;
+        chanObj->pDescriptor    =    NULL;
+        chanObj->descriptorCount =   0U;
         chanObj                 =    chanObj + 1;  /* linked list 'next' */
     }
 
@@ -284,9 +341,33 @@ void DMAC_Initialize( void )
     /* CHBCIE = 1, CHTAIE=1, CHERIE=1, CHSHIE= 0, CHDHIE= 0 */
     DCH0INT = 0xb0000U;
 
+    /* DMA channel 1 configuration */
+    /* CHPRI = 0, CHAEN= 0, CHCHN= 0, CHCHNS= 0x0, CHAED= 0 */
+    DCH1CON = 0x0U;
+    /* CHSIRQ = 0, SIRQEN = 0 */
+    DCH1ECON = 0x0U;
+    /* CHBCIE = 1, CHTAIE=1, CHERIE=1, CHSHIE= 0, CHDHIE= 0 */
+    DCH1INT = 0xb0000U;
+
+    /* DMA channel 2 configuration */
+    /* CHPRI = 0, CHAEN= 0, CHCHN= 0, CHCHNS= 0x0, CHAED= 0 */
+    DCH2CON = 0x0U;
+    /* CHSIRQ = 0, SIRQEN = 0 */
+    DCH2ECON = 0x0U;
+    /* CHBCIE = 1, CHTAIE=1, CHERIE=1, CHSHIE= 0, CHDHIE= 0 */
+    DCH2INT = 0xb0000U;
+
+    /* DMA channel 3 configuration */
+    /* CHPRI = 0, CHAEN= 0, CHCHN= 0, CHCHNS= 0x0, CHAED= 0 */
+    DCH3CON = 0x0U;
+    /* CHSIRQ = 0, SIRQEN = 0 */
+    DCH3ECON = 0x0U;
+    /* CHBCIE = 1, CHTAIE=1, CHERIE=1, CHSHIE= 0, CHDHIE= 0 */
+    DCH3INT = 0xb0000U;
+
 
     /* Enable DMA channel interrupts */
-    IEC4SET = 0U | 0x40U;
+    IEC4SET = 0U | 0x40U | 0x80U | 0x100U | 0x200U;
 
 
 }
@@ -350,6 +431,7 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, size_t src
         *(volatile uint32_t *)(regs) = (_DCH0INT_CHSHIF_MASK |_DCH0INT_CHDHIF_MASK | _DCH0INT_CHBCIF_MASK | _DCH0INT_CHTAIF_MASK| _DCH0INT_CHERIF_MASK);
 
         gDMAChannelObj[channel].inUse = true;
+        gDMAChannelObj[channel].descriptorCount = 0U;
         returnStatus = true;
 
         /* Set the source / destination addresses, DCHxSSA and DCHxDSA */
@@ -424,6 +506,50 @@ bool DMAC_ChainTransferSetup( DMAC_CHANNEL channel, const void *srcAddr, size_t
     return returnStatus;
 }
 
+// *****************************************************************************
+/* Function:
+   bool DMAC_ChannelLinkedListTransfer
+
+  Summary:
+    DMA channel transfer of a list of blocks
+
+  Description:
+    Loads the first descriptor; DMA0_InterruptHandler loads the rest.
+
+  Parameters:
+    DMAC_CHANNEL channel - DMA channel to use for this transfer
+    const DMAC_DESCRIPTOR *descriptors - blocks to transfer, in order
+    size_t count - number of descriptors
+
+  Returns:
+    false, if DMA already is busy / true, if DMA is not busy before calling function
+*/
+bool DMAC_ChannelLinkedListTransfer( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptors, size_t count)
+{
+    bool returnStatus = false;
+    volatile uint32_t *regs;
+    uint32_t DCHxINT_Flags;
+
+    regs = ((volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x20U));
+    DCHxINT_Flags = *(volatile uint32_t *)(regs) & (_DCH0INT_CHERIF_MASK | _DCH0INT_CHTAIF_MASK | _DCH0INT_CHBCIF_MASK);
+
+    if((count != 0U) && ((gDMAChannelObj[channel].inUse == false) || (DCHxINT_Flags != 0U)))
+    {
+        /* Clear all the interrupt flags */
+        regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x20U) + 1U;
+        *(volatile uint32_t *)(regs) = (_DCH0INT_CHSHIF_MASK |_DCH0INT_CHDHIF_MASK | _DCH0INT_CHBCIF_MASK | _DCH0INT_CHTAIF_MASK| _DCH0INT_CHERIF_MASK);
+
+        gDMAChannelObj[channel].inUse = true;
+        gDMAChannelObj[channel].pDescriptor = &descriptors[1];
+        gDMAChannelObj[channel].descriptorCount = count - 1U;
+        returnStatus = true;
+
+        DMAC_ChannelDescriptorLoad(channel, &descriptors[0]);
+    }
+
+    return returnStatus;
+}
+
 void DMAC_ChannelPatternMatchSetup(DMAC_CHANNEL channel, DMAC_DATA_PATTERN_SIZE patternSize, uint16_t patternMatchData)
 {
     volatile __DCH0CONbits_t * controlRegs;
@@ -478,6 +604,70 @@ void DMAC_ChannelDisable (DMAC_CHANNEL channel)
     }
 }
 
+// *****************************************************************************
+/* Function:
+   void DMAC_ChannelPrioritySet (DMAC_CHANNEL channel, DMAC_CHANNEL_PRIORITY priority)
+
+  Summary:
+    Sets the channel priority, DCHxCON.CHPRI
+
+  Description:
+    The channel must be disabled.
+
+  Parameters:
+    DMAC_CHANNEL channel - the particular channel
+    DMAC_CHANNEL_PRIORITY priority - 0 (lowest) to 3 (highest)
+
+  Returns:
+    void
+*/
+void DMAC_ChannelPrioritySet (DMAC_CHANNEL channel, DMAC_CHANNEL_PRIORITY priority)
+{
+    volatile uint32_t * regs;
+
+    /* CHPRI */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x0U)+1U;
+    *(volatile uint32_t *)(regs) = _DCH0CON_CHPRI_MASK;
+
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x0U)+2U;
+    *(volatile uint32_t *)(regs) = ((uint32_t)priority << _DCH0CON_CHPRI_POSITION) & _DCH0CON_CHPRI_MASK;
+}
+
+// *****************************************************************************
+/* Function:
+   void DMAC_ChannelStartIrqSet (DMAC_CHANNEL channel, bool enable, uint32_t startIrq)
+
+  Summary:
+    Selects the interrupt that starts each cell, DCHxECON.CHSIRQ and SIRQEN
+
+  Description:
+    With enable false the channel is started by DMAC_ChannelTransfer itself
+    (CFORCE) and runs the whole block back to back.  The channel must be
+    disabled.
+
+  Parameters:
+    DMAC_CHANNEL channel - the particular channel
+    bool enable - true to start on startIrq
+    uint32_t startIrq - interrupt vector number, ignored when enable is false
+
+  Returns:
+    void
+*/
+void DMAC_ChannelStartIrqSet (DMAC_CHANNEL channel, bool enable, uint32_t startIrq)
+{
+    volatile uint32_t * regs;
+    uint32_t econ = 0U;
+
+    if (enable == true)
+    {
+        econ = ((startIrq << _DCH0ECON_CHSIRQ_POSITION) & _DCH0ECON_CHSIRQ_MASK) | _DCH0ECON_SIRQEN_MASK;
+    }
+
+    /* DCHxECON, keeps PATEN and the abort setup clear */
+    regs = (volatile uint32_t *)(_DMAC_BASE_ADDRESS + 0x60U + (channel * 0xC0U) + 0x10U);
+    *(volatile uint32_t *)(regs) = econ;
+}
+
 // *****************************************************************************
 /* Function:
    bool DMAC_ChannelIsBusy (DMAC_CHANNEL channel)
@@ -731,6 +921,26 @@ void __attribute__((used)) DMA0_InterruptHandler (void)
         chanObj->inUse = false;
     }
 
+    if (dmaEvent == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* Abandon the rest of a linked list transfer */
+        chanObj->descriptorCount = 0U;
+    }
+    else if ((dmaEvent == DMAC_TRANSFER_EVENT_COMPLETE) && (chanObj->descriptorCount != 0U))
+    {
+        /* Load the next block of a linked list transfer, the client is only
+           told about the last one */
+        chanObj->inUse = true;
+        DMAC_ChannelDescriptorLoad(DMAC_CHANNEL_0, chanObj->pDescriptor);
+        chanObj->pDescriptor++;
+        chanObj->descriptorCount--;
+        dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
     /* Clear the interrupt flag and call event handler */
     IFS4CLR = 0x40;
 
@@ -741,3 +951,309 @@ void __attribute__((used)) DMA0_InterruptHandler (void)
         chanObj->pEventCallBack(dmaEvent, hClientArg);
     }
 }
+
+// *****************************************************************************
+/* Function:
+   void DMA1_InterruptHandler (void)
+
+  Summary:
+    Interrupt handler for interrupts from DMA1.
+
+  Description:
+    None
+
+  Parameters:
+    none
+
+  Returns:
+    void
+*/
+void __attribute__((used)) DMA1_InterruptHandler (void)
+{
+    volatile DMAC_CHANNEL_OBJECT *chanObj;
+    DMAC_TRANSFER_EVENT dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+
+    uint32_t var = 0;
+
+    /* Find out the channel object */
+    chanObj = &gDMAChannelObj[1];
+
+    var = DCH1INTbits.CHDHIF;
+    /* Check whether the active DMA channel event has occurred */
+
+    if((DCH1INTbits.CHSHIF == 1U) || (var == 1U))/* irq due to half complete */
+    {
+        /* Do not clear the flag here, it should be cleared with block transfer complete flag*/
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_HALF_COMPLETE;
+        /* Since transfer is only half done yet, do not make inUse flag false */
+    }
+    if(DCH1INTbits.CHTAIF == 1U) /* irq due to transfer abort */
+    {
+        /* Channel is by default disabled on Transfer Abortion */
+        /* Clear the Abort transfer complete flag */
+        DCH1INTCLR = _DCH1INT_CHTAIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+    if(DCH1INTbits.CHBCIF == 1U) /* irq due to transfer complete */
+    {
+        /* Channel is by default disabled on completion of a block transfer */
+        /* Clear the Block transfer complete, half empty and half full interrupt flag */
+        DCH1INTCLR = _DCH1INT_CHBCIF_MASK | _DCH1INT_CHSHIF_MASK | _DCH1INT_CHDHIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_COMPLETE;
+        chanObj->inUse = false;
+    }
+    if(DCH1INTbits.CHERIF == 1U) /* irq due to address error */
+    {
+        /* Clear the address error flag */
+        DCH1INTCLR = _DCH1INT_CHERIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_ADDRESS_ERROR;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+
+    if (dmaEvent == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* Abandon the rest of a linked list transfer */
+        chanObj->descriptorCount = 0U;
+    }
+    else if ((dmaEvent == DMAC_TRANSFER_EVENT_COMPLETE) && (chanObj->descriptorCount != 0U))
+    {
+        /* Load the next block of a linked list transfer, the client is only
+           told about the last one */
+        chanObj->inUse = true;
+        DMAC_ChannelDescriptorLoad(DMAC_CHANNEL_1, chanObj->pDescriptor);
+        chanObj->pDescriptor++;
+        chanObj->descriptorCount--;
+        dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* Clear the interrupt flag and call event handler */
+    IFS4CLR = 0x80;
+
+    if((chanObj->pEventCallBack != NULL) && (dmaEvent != DMAC_TRANSFER_EVENT_NONE))
+    {
+        uintptr_t hClientArg = chanObj->hClientArg;
+
+        chanObj->pEventCallBack(dmaEvent, hClientArg);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+   void DMA2_InterruptHandler (void)
+
+  Summary:
+    Interrupt handler for interrupts from DMA2.
+
+  Description:
+    None
+
+  Parameters:
+    none
+
+  Returns:
+    void
+*/
+void __attribute__((used)) DMA2_InterruptHandler (void)
+{
+    volatile DMAC_CHANNEL_OBJECT *chanObj;
+    DMAC_TRANSFER_EVENT dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+
+    uint32_t var = 0;
+
+    /* Find out the channel object */
+    chanObj = &gDMAChannelObj[2];
+
+    var = DCH2INTbits.CHDHIF;
+    /* Check whether the active DMA channel event has occurred */
+
+    if((DCH2INTbits.CHSHIF == 1U) || (var == 1U))/* irq due to half complete */
+    {
+        /* Do not clear the flag here, it should be cleared with block transfer complete flag*/
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_HALF_COMPLETE;
+        /* Since transfer is only half done yet, do not make inUse flag false */
+    }
+    if(DCH2INTbits.CHTAIF == 1U) /* irq due to transfer abort */
+    {
+        /* Channel is by default disabled on Transfer Abortion */
+        /* Clear the Abort transfer complete flag */
+        DCH2INTCLR = _DCH2INT_CHTAIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+    if(DCH2INTbits.CHBCIF == 1U) /* irq due to transfer complete */
+    {
+        /* Channel is by default disabled on completion of a block transfer */
+        /* Clear the Block transfer complete, half empty and half full interrupt flag */
+        DCH2INTCLR = _DCH2INT_CHBCIF_MASK | _DCH2INT_CHSHIF_MASK | _DCH2INT_CHDHIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_COMPLETE;
+        chanObj->inUse = false;
+    }
+    if(DCH2INTbits.CHERIF == 1U) /* irq due to address error */
+    {
+        /* Clear the address error flag */
+        DCH2INTCLR = _DCH2INT_CHERIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_ADDRESS_ERROR;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+
+    if (dmaEvent == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* Abandon the rest of a linked list transfer */
+        chanObj->descriptorCount = 0U;
+    }
+    else if ((dmaEvent == DMAC_TRANSFER_EVENT_COMPLETE) && (chanObj->descriptorCount != 0U))
+    {
+        /* Load the next block of a linked list transfer, the client is only
+           told about the last one */
+        chanObj->inUse = true;
+        DMAC_ChannelDescriptorLoad(DMAC_CHANNEL_2, chanObj->pDescriptor);
+        chanObj->pDescriptor++;
+        chanObj->descriptorCount--;
+        dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* Clear the interrupt flag and call event handler */
+    IFS4CLR = 0x100;
+
+    if((chanObj->pEventCallBack != NULL) && (dmaEvent != DMAC_TRANSFER_EVENT_NONE))
+    {
+        uintptr_t hClientArg = chanObj->hClientArg;
+
+        chanObj->pEventCallBack(dmaEvent, hClientArg);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+   void DMA3_InterruptHandler (void)
+
+  Summary:
+    Interrupt handler for interrupts from DMA3.
+
+  Description:
+    None
+
+  Parameters:
+    none
+
+  Returns:
+    void
+*/
+void __attribute__((used)) DMA3_InterruptHandler (void)
+{
+    volatile DMAC_CHANNEL_OBJECT *chanObj;
+    DMAC_TRANSFER_EVENT dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+
+    uint32_t var = 0;
+
+    /* Find out the channel object */
+    chanObj = &gDMAChannelObj[3];
+
+    var = DCH3INTbits.CHDHIF;
+    /* Check whether the active DMA channel event has occurred */
+
+    if((DCH3INTbits.CHSHIF == 1U) || (var == 1U))/* irq due to half complete */
+    {
+        /* Do not clear the flag here, it should be cleared with block transfer complete flag*/
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_HALF_COMPLETE;
+        /* Since transfer is only half done yet, do not make inUse flag false */
+    }
+    if(DCH3INTbits.CHTAIF == 1U) /* irq due to transfer abort */
+    {
+        /* Channel is by default disabled on Transfer Abortion */
+        /* Clear the Abort transfer complete flag */
+        DCH3INTCLR = _DCH3INT_CHTAIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+    if(DCH3INTbits.CHBCIF == 1U) /* irq due to transfer complete */
+    {
+        /* Channel is by default disabled on completion of a block transfer */
+        /* Clear the Block transfer complete, half empty and half full interrupt flag */
+        DCH3INTCLR = _DCH3INT_CHBCIF_MASK | _DCH3INT_CHSHIF_MASK | _DCH3INT_CHDHIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_NONE;
+        dmaEvent = DMAC_TRANSFER_EVENT_COMPLETE;
+        chanObj->inUse = false;
+    }
+    if(DCH3INTbits.CHERIF == 1U) /* irq due to address error */
+    {
+        /* Clear the address error flag */
+        DCH3INTCLR = _DCH3INT_CHERIF_MASK;
+
+        /* Update error and event */
+        chanObj->errorInfo = DMAC_ERROR_ADDRESS_ERROR;
+        dmaEvent = DMAC_TRANSFER_EVENT_ERROR;
+        chanObj->inUse = false;
+    }
+
+    if (dmaEvent == DMAC_TRANSFER_EVENT_ERROR)
+    {
+        /* Abandon the rest of a linked list transfer */
+        chanObj->descriptorCount = 0U;
+    }
+    else if ((dmaEvent == DMAC_TRANSFER_EVENT_COMPLETE) && (chanObj->descriptorCount != 0U))
+    {
+        /* Load the next block of a linked list transfer, the client is only
+           told about the last one */
+        chanObj->inUse = true;
+        DMAC_ChannelDescriptorLoad(DMAC_CHANNEL_3, chanObj->pDescriptor);
+        chanObj->pDescriptor++;
+        chanObj->descriptorCount--;
+        dmaEvent = DMAC_TRANSFER_EVENT_NONE;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    /* Clear the interrupt flag and call event handler */
+    IFS4CLR = 0x200;
+
+    if((chanObj->pEventCallBack != NULL) && (dmaEvent != DMAC_TRANSFER_EVENT_NONE))
+    {
+        uintptr_t hClientArg = chanObj->hClientArg;
+
+        chanObj->pEventCallBack(dmaEvent, hClientArg);
+    }
+}
@@ -149,6 +149,33 @@ typedef enum
 
 typedef void (*DMAC_CHANNEL_CALLBACK) (DMAC_TRANSFER_EVENT status, uintptr_t contextHandle);
 
+// *****************************************************************************
+/* DMA transfer descriptor
+
+  Summary:
+    One block of a linked list transfer.
+
+  Description:
+    Same parameters as DMAC_ChannelTransfer.  The descriptors of a list are
+    loaded into the channel one after the other.
+
+  Remarks:
+    None
+*/
+typedef struct
+{
+    const void *srcAddr;
+
+    size_t srcSize;
+
+    const void *destAddr;
+
+    size_t destSize;
+
+    size_t cellSize;
+
+} DMAC_DESCRIPTOR;
+
 // *****************************************************************************
 /* DMA channel object
 
@@ -176,6 +203,10 @@ typedef struct
     /* Client data(Event Context) that will be returned at callback */
     uintptr_t hClientArg;
 
+    /* Descriptors of a linked list transfer still to be loaded */
+    const DMAC_DESCRIPTOR *pDescriptor;
+    size_t descriptorCount;
+
 } DMAC_CHANNEL_OBJECT;
 
 // *****************************************************************************
@@ -210,6 +241,30 @@ typedef struct
 
 typedef uint32_t DMAC_CHANNEL;
 
+// *****************************************************************************
+/* DMA channel priority
+
+  Summary:
+    Value of DCHxCON.CHPRI, arbitration between pending channels.
+
+  Description:
+    None
+
+  Remarks:
+    None
+*/
+typedef enum
+{
+    DMAC_CHANNEL_PRIORITY_0 = 0,
+
+    DMAC_CHANNEL_PRIORITY_1 = 1,
+
+    DMAC_CHANNEL_PRIORITY_2 = 2,
+
+    DMAC_CHANNEL_PRIORITY_3 = 3
+
+} DMAC_CHANNEL_PRIORITY;
+
 // *****************************************************************************
 /* DMA CRC Setup
 
@@ -310,6 +365,42 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, size_t src
 
 bool DMAC_ChainTransferSetup( DMAC_CHANNEL channel, const void *srcAddr, size_t srcSize, const void *destAddr, size_t destSize, size_t cellSize);
 
+// *****************************************************************************
+/* Function:
+   bool DMAC_ChannelLinkedListTransfer
+
+  Summary:
+    DMA channel transfer of a list of blocks
+
+  Description:
+    Transfers count non-contiguous blocks back to back on one channel.  When a
+    block completes, the channel interrupt handler loads the next descriptor
+    and re-enables the channel itself, so the registered callback is called
+    only once, after the last block or on the first error.
+
+    The descriptor array is not copied and must stay valid until the
+    callback.
+
+  Parameters:
+    DMAC_CHANNEL channel - DMA channel to use for this transfer
+    const DMAC_DESCRIPTOR *descriptors - blocks to transfer, in order
+    size_t count - number of descriptors, at least 1
+
+  Returns:
+    false, if DMA already is busy / true, if DMA is not busy before calling function
+
+  Example:
+    <code>
+    static const DMAC_DESCRIPTOR list[2] = {
+        {header, sizeof(header), (const void *)&U6TXREG, 1, 1},
+        {payload, payloadSize, (const void *)&U6TXREG, 1, 1}
+    };
+
+    DMAC_ChannelLinkedListTransfer(DMAC_CHANNEL_0, list, 2);
+    </code>
+*/
+bool DMAC_ChannelLinkedListTransfer( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptors, size_t count);
+
 void DMAC_ChannelPatternMatchSetup(DMAC_CHANNEL channel, DMAC_DATA_PATTERN_SIZE patternSize, uint16_t patternMatchData);
 void DMAC_ChannelPatternMatchDisable(DMAC_CHANNEL channel);
 // *****************************************************************************
@@ -362,6 +453,34 @@ void DMAC_ChannelDisable (DMAC_CHANNEL channel);
 */
 bool DMAC_ChannelIsBusy (DMAC_CHANNEL channel);
 
+// *****************************************************************************
+/* Function:
+   void DMAC_ChannelPrioritySet (DMAC_CHANNEL channel, DMAC_CHANNEL_PRIORITY priority)
+
+  Summary:
+    Sets the arbitration priority of a disabled channel.
+
+  Example:
+    <code>
+    DMAC_ChannelPrioritySet(DMAC_CHANNEL_1, DMAC_CHANNEL_PRIORITY_3);
+    </code>
+*/
+void DMAC_ChannelPrioritySet (DMAC_CHANNEL channel, DMAC_CHANNEL_PRIORITY priority);
+
+// *****************************************************************************
+/* Function:
+   void DMAC_ChannelStartIrqSet (DMAC_CHANNEL channel, bool enable, uint32_t startIrq)
+
+  Summary:
+    Selects the interrupt that starts a disabled channel, or software start.
+
+  Example:
+    <code>
+    DMAC_ChannelStartIrqSet(DMAC_CHANNEL_1, true, INT_SOURCE_UART6_TX);
+    </code>
+*/
+void DMAC_ChannelStartIrqSet (DMAC_CHANNEL channel, bool enable, uint32_t startIrq);
+
 // *****************************************************************************
 /* Function:
    void DMAC_ChannelCRCSetup
@@ -59,6 +59,9 @@ void EVIC_Initialize( void )
     IPC30SET = 0x4U | 0x0U;  /* CHANGE_NOTICE_C:  Priority 1 / Subpriority 0 */
     IPC31SET = 0x40000U | 0x0U;  /* CHANGE_NOTICE_J:  Priority 1 / Subpriority 0 */
     IPC33SET = 0x40000U | 0x0U;  /* DMA0:  Priority 1 / Subpriority 0 */
+    IPC33SET = 0x4000000U | 0x0U;  /* DMA1:  Priority 1 / Subpriority 0 */
+    IPC34SET = 0x4U | 0x0U;  /* DMA2:  Priority 1 / Subpriority 0 */
+    IPC34SET = 0x400U | 0x0U;  /* DMA3:  Priority 1 / Subpriority 0 */
 
 
 }
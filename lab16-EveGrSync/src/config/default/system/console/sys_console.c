@@ -0,0 +1,144 @@
+/*******************************************************************************
+  System Console Service
+
+  File Name:
+    sys_console.c
+
+  Summary:
+    Early boot and panic text output on UART6.
+
+  Description:
+    The polled path only checks UTXBF, TRMT is looked at once by
+    SYS_CONSOLE_Flush.  The queued path goes through the DMA log service, so
+    the console never touches UART6 while the log DMAC channel owns it.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "system/log/sys_log.h"
+#include "sys_console.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static volatile bool sysConsolePanic = false;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool SYS_CONSOLE_IsPolled( void )
+{
+    return ((sysConsolePanic == true) ||
+            (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED));
+}
+
+static void SYS_CONSOLE_PolledWrite( const char *buffer, size_t size )
+{
+    while (size > 0U)
+    {
+        /* Keep the 8 deep FIFO topped up, the shift register drains behind us */
+        while ((U6STA & _U6STA_UTXBF_MASK) != 0U)
+        {
+            /* Wait for room in the FIFO */
+        }
+
+        U6TXREG = (uint8_t)*buffer;
+        buffer++;
+        size--;
+    }
+}
+
+static void SYS_CONSOLE_Write( const char *buffer, size_t size )
+{
+    if (SYS_CONSOLE_IsPolled() == true)
+    {
+        SYS_CONSOLE_PolledWrite(buffer, size);
+    }
+    else if (uxInterruptNesting != 0U)
+    {
+        (void)SYS_LOG_WriteFromISR(buffer, size);
+    }
+    else
+    {
+        (void)SYS_LOG_Write(buffer, size);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_CONSOLE_Print( const char *msg )
+{
+    SYS_CONSOLE_Write(msg, strlen(msg));
+}
+
+void SYS_CONSOLE_PrintHex( uint32_t value )
+{
+    static const char hexDigit[] = "0123456789ABCDEF";
+    char text[10];
+    uint32_t i;
+
+    text[0] = '0';
+    text[1] = 'x';
+    for (i = 0U; i < 8U; i++)
+    {
+        text[9U - i] = hexDigit[value & 0xFU];
+        value >>= 4U;
+    }
+
+    SYS_CONSOLE_Write(text, sizeof(text));
+}
+
+void SYS_CONSOLE_PrintDec( uint32_t value )
+{
+    char text[10];
+    uint32_t first = sizeof(text);
+
+    do
+    {
+        first--;
+        text[first] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    SYS_CONSOLE_Write(&text[first], sizeof(text) - first);
+}
+
+void SYS_CONSOLE_PanicEnter( void )
+{
+    (void)__builtin_disable_interrupts();
+
+    if (sysConsolePanic == false)
+    {
+        sysConsolePanic = true;
+        SYS_LOG_Halt();
+    }
+}
+
+void SYS_CONSOLE_Flush( void )
+{
+    if (SYS_CONSOLE_IsPolled() == true)
+    {
+        while ((U6STA & _U6STA_TRMT_MASK) == 0U)
+        {
+            /* Wait for the shift register to empty */
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+  System Console Service
+
+  File Name:
+    sys_console.h
+
+  Summary:
+    Early boot and panic text output on UART6.
+
+  Description:
+    Replaces the per character Debug_msg loop that waited for the transmit
+    shift register to drain after every byte.
+
+    Before the scheduler starts the console writes the UART6 hardware FIFO
+    directly and only waits while the FIFO is full (UTXBF), so the line keeps
+    running at full rate.  Once the scheduler is running, text is handed to
+    the DMA log service and the caller returns at once.  After
+    SYS_CONSOLE_PanicEnter the console goes back to polled FIFO writes with
+    interrupts masked, which is the only mode guaranteed to get a message out
+    of an assert or exception handler.
+*******************************************************************************/
+
+#ifndef SYS_CONSOLE_H
+#define SYS_CONSOLE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_CONSOLE_Print( const char *msg )
+
+  Summary:
+    Writes a NUL terminated string to the console.
+
+  Description:
+    Polled FIFO fill before the scheduler starts and after
+    SYS_CONSOLE_PanicEnter, queued to the log service otherwise.  May be
+    called from tasks and from interrupt handlers running at or below
+    configMAX_SYSCALL_INTERRUPT_PRIORITY.
+*/
+void SYS_CONSOLE_Print( const char *msg );
+
+// *****************************************************************************
+/* Function:
+    void SYS_CONSOLE_PrintHex( uint32_t value )
+    void SYS_CONSOLE_PrintDec( uint32_t value )
+
+  Summary:
+    Writes a number without going through the C library.
+
+  Description:
+    Meant for fault reports where printf may not be usable.  Hex output is
+    always 8 digits with a 0x prefix.
+*/
+void SYS_CONSOLE_PrintHex( uint32_t value );
+void SYS_CONSOLE_PrintDec( uint32_t value );
+
+// *****************************************************************************
+/* Function:
+    void SYS_CONSOLE_PanicEnter( void )
+
+  Summary:
+    Switches the console to synchronous output for good.
+
+  Description:
+    Masks interrupts, stops the log service once its current segment is out
+    and makes every later print a polled FIFO write.  There is no way back,
+    call it only on paths that never return to the scheduler.
+*/
+void SYS_CONSOLE_PanicEnter( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_CONSOLE_Flush( void )
+
+  Summary:
+    In polled mode, waits until the last character has left the pin.
+*/
+void SYS_CONSOLE_Flush( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_CONSOLE_H
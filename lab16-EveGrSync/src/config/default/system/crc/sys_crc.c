@@ -0,0 +1,410 @@
+/*******************************************************************************
+  System CRC Service
+
+  File Name:
+    sys_crc.c
+
+  Summary:
+    CRC-16/CCITT-FALSE and CRC-32 by table or by the DMAC CRC engine.
+
+  Description:
+    The DMAC engine is an augmented LFSR.  It needs the seed in its non
+    direct form and the message followed by one CRC width of zero bits.  The
+    zeros are sent as a second descriptor of the same linked list transfer,
+    so the caller's buffer is used as is.  The engine runs in append mode:
+    data goes into the CRC only and the result is written to a scratch word.
+
+    The engine serves one channel at a time, a mutex serializes callers.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "system/dma/sys_dma.h"
+#include "system/dma/sys_dma_cache.h"
+#include "sys_crc.h"
+
+#if (SYS_CRC_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+    #error SYS_CRC_NOTIFY_INDEX needs a larger configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_CRC16_POLYNOMIAL        (0x1021U)
+#define SYS_CRC16_INIT              (0xFFFFU)
+
+#define SYS_CRC32_POLYNOMIAL        (0x04C11DB7U)
+#define SYS_CRC32_POLYNOMIAL_REV    (0xEDB88320U)
+#define SYS_CRC32_INIT              (0xFFFFFFFFU)
+
+/* DCHxSSIZ is 16 bit, larger buffers are split over several descriptors */
+#define SYS_CRC_DMA_CHUNK           (0xFFF0U)
+#define SYS_CRC_DMA_DESCRIPTORS     (8U)
+
+static uint16_t sysCrc16Table[256];
+static uint32_t sysCrc32Table[8][256];
+
+static DMAC_CHANNEL sysCrcChannel = SYS_DMA_CHANNEL_NONE;
+static SemaphoreHandle_t sysCrcMutex;
+static StaticSemaphore_t sysCrcMutexObj;
+static TaskHandle_t sysCrcWaitingTask;
+static volatile DMAC_TRANSFER_EVENT sysCrcEvent;
+
+static DMAC_DESCRIPTOR sysCrcDescriptor[SYS_CRC_DMA_DESCRIPTORS + 1U];
+
+/* The augmenting zeros and the append mode result, cache line aligned so
+   the cache maintenance on them stays private */
+static uint8_t SYS_DMA_BUFFER(sysCrcZeros, 4U);
+static uint8_t SYS_DMA_BUFFER(sysCrcResult, 4U);
+
+/* Self test input, the lengths and offsets cover the byte wise head and
+   tail of slice-by-8 and a DMA source that is not word aligned */
+#define SYS_CRC_TEST_SIZE           (1040U)
+
+static const uint8_t sysCrcCheckInput[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+static const size_t sysCrcTestLength[] = { 1U, 9U, 64U, 513U, 1031U };
+static uint8_t sysCrcTestBuffer[SYS_CRC_TEST_SIZE];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Runs the LFSR backwards over one width of zeros, turning a direct seed
+   into the seed the augmented engine needs */
+static uint32_t SYS_CRC_NonDirectSeed( uint32_t seed, uint32_t polynomial, uint32_t width )
+{
+    uint32_t top = 1UL << (width - 1U);
+    uint32_t i;
+
+    for (i = 0U; i < width; i++)
+    {
+        if ((seed & 1U) != 0U)
+        {
+            seed = ((seed ^ polynomial) >> 1U) | top;
+        }
+        else
+        {
+            seed >>= 1U;
+        }
+    }
+
+    return seed;
+}
+
+static uint32_t SYS_CRC_Update32( uint32_t crc, const uint8_t *data, size_t size )
+{
+    /* Byte wise up to a word boundary */
+    while ((size > 0U) && (((uint32_t)data & 3U) != 0U))
+    {
+        crc = sysCrc32Table[0][(crc ^ *data) & 0xFFU] ^ (crc >> 8U);
+        data++;
+        size--;
+    }
+
+    /* Slice-by-8 */
+    while (size >= 8U)
+    {
+        uint32_t one;
+        uint32_t two;
+
+        (void)memcpy(&one, data, sizeof(one));
+        (void)memcpy(&two, data + 4, sizeof(two));
+        one ^= crc;
+
+        crc = sysCrc32Table[7][one & 0xFFU] ^
+              sysCrc32Table[6][(one >> 8U) & 0xFFU] ^
+              sysCrc32Table[5][(one >> 16U) & 0xFFU] ^
+              sysCrc32Table[4][one >> 24U] ^
+              sysCrc32Table[3][two & 0xFFU] ^
+              sysCrc32Table[2][(two >> 8U) & 0xFFU] ^
+              sysCrc32Table[1][(two >> 16U) & 0xFFU] ^
+              sysCrc32Table[0][two >> 24U];
+
+        data += 8;
+        size -= 8U;
+    }
+
+    while (size > 0U)
+    {
+        crc = sysCrc32Table[0][(crc ^ *data) & 0xFFU] ^ (crc >> 8U);
+        data++;
+        size--;
+    }
+
+    return crc;
+}
+
+static uint32_t SYS_CRC_Update16( uint32_t crc, const uint8_t *data, size_t size )
+{
+    while (size > 0U)
+    {
+        crc = ((crc << 8U) ^ sysCrc16Table[((crc >> 8U) ^ *data) & 0xFFU]) & 0xFFFFU;
+        data++;
+        size--;
+    }
+
+    return crc;
+}
+
+static void SYS_CRC_DmaHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    (void)context;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) != 0U)
+    {
+        sysCrcEvent = event;
+        vTaskNotifyGiveIndexedFromISR(sysCrcWaitingTask, SYS_CRC_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+/* Runs the buffer through the DMAC engine, false if it could not */
+static bool SYS_CRC_DmaCalculate( SYS_CRC_TYPE type, const uint8_t *data, size_t size, uint32_t *crc )
+{
+    DMAC_CRC_SETUP setup;
+    uint32_t count = 0U;
+    uint32_t width;
+
+    if (type == SYS_CRC_TYPE_CRC32)
+    {
+        width = 32U;
+        setup.reverse_crc_input = true;
+        setup.polynomial = SYS_CRC32_POLYNOMIAL;
+        setup.non_direct_seed = SYS_CRC_NonDirectSeed(SYS_CRC32_INIT, SYS_CRC32_POLYNOMIAL, width);
+        setup.reverse_crc_output = true;
+        setup.final_xor_value = 0xFFFFFFFFU;
+    }
+    else
+    {
+        width = 16U;
+        setup.reverse_crc_input = false;
+        setup.polynomial = SYS_CRC16_POLYNOMIAL;
+        setup.non_direct_seed = SYS_CRC_NonDirectSeed(SYS_CRC16_INIT, SYS_CRC16_POLYNOMIAL, width);
+        setup.reverse_crc_output = false;
+        setup.final_xor_value = 0U;
+    }
+    setup.append_mode = true;
+    setup.polynomial_length = (uint8_t)width;
+
+    if (size > (SYS_CRC_DMA_CHUNK * SYS_CRC_DMA_DESCRIPTORS))
+    {
+        return false;
+    }
+
+    (void)xSemaphoreTake(sysCrcMutex, portMAX_DELAY);
+
+    while (size > 0U)
+    {
+        size_t chunk = (size > SYS_CRC_DMA_CHUNK) ? SYS_CRC_DMA_CHUNK : size;
+
+        sysCrcDescriptor[count].srcAddr = data;
+        sysCrcDescriptor[count].srcSize = chunk;
+        sysCrcDescriptor[count].destAddr = sysCrcResult;
+        sysCrcDescriptor[count].destSize = width / 8U;
+        sysCrcDescriptor[count].cellSize = chunk;
+        count++;
+
+        SYS_DMA_CachePrepare(data, chunk, SYS_DMA_CACHE_TO_DEVICE);
+        data += chunk;
+        size -= chunk;
+    }
+
+    sysCrcDescriptor[count].srcAddr = sysCrcZeros;
+    sysCrcDescriptor[count].srcSize = width / 8U;
+    sysCrcDescriptor[count].destAddr = sysCrcResult;
+    sysCrcDescriptor[count].destSize = width / 8U;
+    sysCrcDescriptor[count].cellSize = width / 8U;
+    count++;
+
+    SYS_DMA_CachePrepare(sysCrcResult, sizeof(sysCrcResult), SYS_DMA_CACHE_FROM_DEVICE);
+
+    sysCrcWaitingTask = xTaskGetCurrentTaskHandle();
+    sysCrcEvent = DMAC_TRANSFER_EVENT_NONE;
+    (void)ulTaskNotifyTakeIndexed(SYS_CRC_NOTIFY_INDEX, pdTRUE, 0);
+
+    DMAC_ChannelCRCSetup(sysCrcChannel, setup);
+
+    if (DMAC_ChannelLinkedListTransfer(sysCrcChannel, sysCrcDescriptor, count) == true)
+    {
+        (void)ulTaskNotifyTakeIndexed(SYS_CRC_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+    }
+
+    if (sysCrcEvent == DMAC_TRANSFER_EVENT_COMPLETE)
+    {
+        *crc = DMAC_CRCRead() & (0xFFFFFFFFU >> (32U - width));
+    }
+
+    DMAC_CRCDisable();
+
+    (void)xSemaphoreGive(sysCrcMutex);
+
+    return (sysCrcEvent == DMAC_TRANSFER_EVENT_COMPLETE);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_CRC_Initialize( void )
+{
+    uint32_t i;
+    uint32_t k;
+
+    for (i = 0U; i < 256U; i++)
+    {
+        uint32_t crc32 = i;
+        uint32_t crc16 = i << 8U;
+
+        for (k = 0U; k < 8U; k++)
+        {
+            crc32 = ((crc32 & 1U) != 0U) ? ((crc32 >> 1U) ^ SYS_CRC32_POLYNOMIAL_REV) : (crc32 >> 1U);
+            crc16 = ((crc16 & 0x8000U) != 0U) ? ((crc16 << 1U) ^ SYS_CRC16_POLYNOMIAL) : (crc16 << 1U);
+        }
+
+        sysCrc32Table[0][i] = crc32;
+        sysCrc16Table[i] = (uint16_t)crc16;
+    }
+
+    for (i = 0U; i < 256U; i++)
+    {
+        for (k = 1U; k < 8U; k++)
+        {
+            uint32_t previous = sysCrc32Table[k - 1U][i];
+
+            sysCrc32Table[k][i] = (previous >> 8U) ^ sysCrc32Table[0][previous & 0xFFU];
+        }
+    }
+
+    (void)memset(sysCrcZeros, 0, sizeof(sysCrcZeros));
+    SYS_DMA_CachePrepare(sysCrcZeros, sizeof(sysCrcZeros), SYS_DMA_CACHE_TO_DEVICE);
+
+    sysCrcMutex = xSemaphoreCreateMutexStatic(&sysCrcMutexObj);
+
+    sysCrcChannel = SYS_DMA_ChannelAllocate(DMAC_CHANNEL_PRIORITY_0, SYS_DMA_START_IRQ_NONE);
+    if (sysCrcChannel != SYS_DMA_CHANNEL_NONE)
+    {
+        DMAC_ChannelCallbackRegister(sysCrcChannel, SYS_CRC_DmaHandler, 0);
+    }
+}
+
+void SYS_CRC_Start( SYS_CRC_CONTEXT *context, SYS_CRC_TYPE type )
+{
+    context->type = type;
+    context->crc = (type == SYS_CRC_TYPE_CRC32) ? SYS_CRC32_INIT : SYS_CRC16_INIT;
+}
+
+void SYS_CRC_Update( SYS_CRC_CONTEXT *context, const void *data, size_t size )
+{
+    if (context->type == SYS_CRC_TYPE_CRC32)
+    {
+        context->crc = SYS_CRC_Update32(context->crc, (const uint8_t *)data, size);
+    }
+    else
+    {
+        context->crc = SYS_CRC_Update16(context->crc, (const uint8_t *)data, size);
+    }
+}
+
+uint32_t SYS_CRC_Finish( const SYS_CRC_CONTEXT *context )
+{
+    return (context->type == SYS_CRC_TYPE_CRC32) ? (context->crc ^ 0xFFFFFFFFU) : context->crc;
+}
+
+uint32_t SYS_CRC_Calculate( SYS_CRC_TYPE type, const void *data, size_t size )
+{
+    SYS_CRC_CONTEXT context;
+    uint32_t crc = 0U;
+
+    if ((size >= SYS_CRC_DMA_THRESHOLD) &&
+        (sysCrcChannel != SYS_DMA_CHANNEL_NONE) &&
+        (uxInterruptNesting == 0U) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        if (SYS_CRC_DmaCalculate(type, (const uint8_t *)data, size, &crc) == true)
+        {
+            return crc;
+        }
+    }
+
+    SYS_CRC_Start(&context, type);
+    SYS_CRC_Update(&context, data, size);
+
+    return SYS_CRC_Finish(&context);
+}
+
+bool SYS_CRC_SelfTest( void )
+{
+    static const uint32_t check[2] = { 0x29B1U, 0xCBF43926U };
+    bool passed = true;
+    uint32_t type;
+    uint32_t i;
+
+    for (i = 0U; i < SYS_CRC_TEST_SIZE; i++)
+    {
+        sysCrcTestBuffer[i] = (uint8_t)((i * 7U) + (i >> 8U));
+    }
+
+    for (type = 0U; type < 2U; type++)
+    {
+        SYS_CRC_CONTEXT context;
+        uint32_t crc = 0U;
+        uint32_t offset;
+        uint32_t k;
+
+        SYS_CRC_Start(&context, (SYS_CRC_TYPE)type);
+        SYS_CRC_Update(&context, sysCrcCheckInput, sizeof(sysCrcCheckInput));
+        if (SYS_CRC_Finish(&context) != check[type])
+        {
+            passed = false;
+        }
+
+        if (sysCrcChannel == SYS_DMA_CHANNEL_NONE)
+        {
+            continue;
+        }
+
+        if ((SYS_CRC_DmaCalculate((SYS_CRC_TYPE)type, sysCrcCheckInput, sizeof(sysCrcCheckInput), &crc) == false) ||
+            (crc != check[type]))
+        {
+            passed = false;
+        }
+
+        for (offset = 0U; offset < 4U; offset++)
+        {
+            for (k = 0U; k < (sizeof(sysCrcTestLength) / sizeof(sysCrcTestLength[0])); k++)
+            {
+                const uint8_t *data = &sysCrcTestBuffer[offset];
+
+                SYS_CRC_Start(&context, (SYS_CRC_TYPE)type);
+                SYS_CRC_Update(&context, data, sysCrcTestLength[k]);
+
+                if ((SYS_CRC_DmaCalculate((SYS_CRC_TYPE)type, data, sysCrcTestLength[k], &crc) == false) ||
+                    (crc != SYS_CRC_Finish(&context)))
+                {
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    return passed;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+  System CRC Service
+
+  File Name:
+    sys_crc.h
+
+  Summary:
+    CRC-16/CCITT-FALSE and CRC-32 by table or by the DMAC CRC engine.
+
+  Description:
+    The streaming functions (SYS_CRC_Start / Update / Finish) run on the CPU:
+    CRC-32 uses slice-by-8 tables, CRC-16 a byte table.  They can follow a
+    message that is produced in pieces, e.g. a telemetry frame assembled
+    field by field.
+
+    SYS_CRC_Calculate checks one buffer in a single call.  Large buffers
+    from a running task are sent through the DMAC CRC engine on a software
+    started channel, and the task sleeps until it is done.  Both paths give
+    the same result.
+
+    Check values for "123456789": CRC-16 0x29B1, CRC-32 0xCBF43926.
+*******************************************************************************/
+
+#ifndef SYS_CRC_H
+#define SYS_CRC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Smallest buffer SYS_CRC_Calculate hands to the DMAC. */
+#ifndef SYS_CRC_DMA_THRESHOLD
+    #define SYS_CRC_DMA_THRESHOLD       (512U)
+#endif
+
+/* Task notification index used to wait for the DMAC. */
+#ifndef SYS_CRC_NOTIFY_INDEX
+    #define SYS_CRC_NOTIFY_INDEX        (1U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    /* poly 0x1021, init 0xFFFF, not reflected, no final xor */
+    SYS_CRC_TYPE_CRC16_CCITT = 0,
+
+    /* poly 0x04C11DB7, init and final xor 0xFFFFFFFF, reflected (zlib, Ethernet) */
+    SYS_CRC_TYPE_CRC32
+
+} SYS_CRC_TYPE;
+
+typedef struct
+{
+    SYS_CRC_TYPE type;
+    uint32_t crc;
+
+} SYS_CRC_CONTEXT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_CRC_Initialize( void )
+
+  Summary:
+    Builds the tables and takes a DMAC channel for SYS_CRC_Calculate.
+
+  Description:
+    Call once after SYS_DMA_Initialize and before the scheduler starts.
+*/
+void SYS_CRC_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_CRC_Start( SYS_CRC_CONTEXT *context, SYS_CRC_TYPE type )
+    void SYS_CRC_Update( SYS_CRC_CONTEXT *context, const void *data, size_t size )
+    uint32_t SYS_CRC_Finish( const SYS_CRC_CONTEXT *context )
+
+  Summary:
+    Streaming CRC on the CPU, callable from any context.
+*/
+void SYS_CRC_Start( SYS_CRC_CONTEXT *context, SYS_CRC_TYPE type );
+void SYS_CRC_Update( SYS_CRC_CONTEXT *context, const void *data, size_t size );
+uint32_t SYS_CRC_Finish( const SYS_CRC_CONTEXT *context );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_CRC_Calculate( SYS_CRC_TYPE type, const void *data, size_t size )
+
+  Summary:
+    CRC of one buffer, by the DMAC engine when it is worth it.
+
+  Description:
+    The buffer must not change until the function returns.
+*/
+uint32_t SYS_CRC_Calculate( SYS_CRC_TYPE type, const void *data, size_t size );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_CRC_SelfTest( void )
+
+  Summary:
+    Checks both paths against the check values and against each other.
+
+  Description:
+    The table path must give the "123456789" check values.  The DMAC path
+    must give them too, and must match the table on a few lengths from 1 to
+    1031 bytes starting at each byte offset of a word.  The DMAC part is
+    skipped when SYS_CRC_Initialize got no channel.
+
+    Call from a task once the scheduler runs, it waits for the DMAC.
+*/
+bool SYS_CRC_SelfTest( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_CRC_H
@@ -0,0 +1,280 @@
+/*******************************************************************************
+  System Input Debounce Service
+
+  File Name:
+    sys_debounce.c
+
+  Summary:
+    Debounces many GPIO inputs with one software timer.
+
+  Description:
+    Bit i of every word belongs to input i.  The two counter words hold a 2
+    bit down counter per input that sits at 3 while the raw sample equals
+    the debounced state, counts down on each sample that differs and toggles
+    the state when it wraps from 0 back to 3.
+
+    The timer stops itself inside a critical section only if no change
+    notice came in since the sample was taken, so a wake between the sample
+    and the stop is never lost, and a wake after it finds the timer stopped
+    and starts it again.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "sys_debounce.h"
+
+#if (SYS_DEBOUNCE_MAX_INPUTS > 32U)
+    #error SYS_DEBOUNCE_MAX_INPUTS must not exceed the 32 bits of a word
+#endif
+
+#if (SYS_DEBOUNCE_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+    #error SYS_DEBOUNCE_NOTIFY_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+/* Ports A to K, the index of a port is pin >> 4 */
+#define SYS_DEBOUNCE_PORT_COUNT         (GPIO_PORT_K + 1U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    SYS_DEBOUNCE_INPUT input[SYS_DEBOUNCE_MAX_INPUTS];
+    uint32_t count;
+
+    /* Ports holding at least one input, one bit per port */
+    uint32_t ports;
+
+    /* Inputs pressed at a low level, flipped so 1 is always pressed */
+    uint32_t activeLow;
+
+    /* Debounced state and the vertical counters */
+    uint32_t state;
+    uint32_t ct0;
+    uint32_t ct1;
+
+    bool continuous;
+
+    /* Timer started and not yet stopped */
+    volatile bool running;
+
+    /* Change notice since the last sample */
+    volatile bool pending;
+
+    TimerHandle_t timer;
+    StaticTimer_t timerObj;
+
+} SYS_DEBOUNCE_OBJECT;
+
+static SYS_DEBOUNCE_OBJECT sysDebounceObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Raw pressed bits of all inputs, each port read once */
+static uint32_t SYS_DEBOUNCE_Sample( void )
+{
+    uint32_t level[SYS_DEBOUNCE_PORT_COUNT] = { 0U };
+    uint32_t raw = 0U;
+    uint32_t i;
+    GPIO_PIN pin;
+
+    for (i = 0U; i < SYS_DEBOUNCE_PORT_COUNT; i++)
+    {
+        if ((sysDebounceObj.ports & (1UL << i)) != 0U)
+        {
+            level[i] = GPIO_PortRead((GPIO_PORT)i);
+        }
+    }
+
+    for (i = 0U; i < sysDebounceObj.count; i++)
+    {
+        pin = sysDebounceObj.input[i].pin;
+        raw |= ((level[pin >> 4U] >> (pin & 0xFU)) & 1UL) << i;
+    }
+
+    return raw ^ sysDebounceObj.activeLow;
+}
+
+/* Runs all counters one sample, returns the inputs that changed state */
+static uint32_t SYS_DEBOUNCE_Filter( uint32_t raw )
+{
+    uint32_t delta = raw ^ sysDebounceObj.state;
+
+    sysDebounceObj.ct0 = ~(sysDebounceObj.ct0 & delta);
+    sysDebounceObj.ct1 = sysDebounceObj.ct0 ^ (sysDebounceObj.ct1 & delta);
+
+    delta &= sysDebounceObj.ct0 & sysDebounceObj.ct1;
+    sysDebounceObj.state ^= delta;
+
+    return delta;
+}
+
+static void SYS_DEBOUNCE_Report( uint32_t changes )
+{
+    const SYS_DEBOUNCE_INPUT *input;
+    uint32_t i;
+    uint32_t bits;
+
+    while (changes != 0U)
+    {
+        i = (uint32_t)__builtin_ctz(changes);
+        changes &= changes - 1U;
+
+        input = &sysDebounceObj.input[i];
+        bits = ((sysDebounceObj.state & (1UL << i)) != 0U) ? input->pressBits : input->releaseBits;
+        if (bits == 0U)
+        {
+            continue;
+        }
+
+        if (input->eventGroup != NULL)
+        {
+            (void)xEventGroupSetBits(input->eventGroup, (EventBits_t)bits);
+        }
+        if (input->task != NULL)
+        {
+            (void)xTaskNotifyIndexed(input->task, SYS_DEBOUNCE_NOTIFY_INDEX, bits, eSetBits);
+        }
+    }
+}
+
+static void SYS_DEBOUNCE_TimerCallback( TimerHandle_t xTimer )
+{
+    uint32_t raw;
+
+    sysDebounceObj.pending = false;
+
+    raw = SYS_DEBOUNCE_Sample();
+    SYS_DEBOUNCE_Report(SYS_DEBOUNCE_Filter(raw));
+
+    if ((sysDebounceObj.continuous == true) || (raw != sysDebounceObj.state))
+    {
+        return;
+    }
+
+    /* All inputs settled, the counters are back at 3 */
+    taskENTER_CRITICAL();
+    if (sysDebounceObj.pending == false)
+    {
+        sysDebounceObj.running = false;
+        (void)xTimerStop(xTimer, 0);
+    }
+    taskEXIT_CRITICAL();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_DEBOUNCE_Initialize( bool continuous )
+{
+    configASSERT(pdMS_TO_TICKS(SYS_DEBOUNCE_SAMPLE_MS) > 0U);
+
+    sysDebounceObj.count = 0U;
+    sysDebounceObj.ports = 0U;
+    sysDebounceObj.activeLow = 0U;
+    sysDebounceObj.state = 0U;
+    sysDebounceObj.ct0 = 0xFFFFFFFFU;
+    sysDebounceObj.ct1 = 0xFFFFFFFFU;
+    sysDebounceObj.continuous = continuous;
+    sysDebounceObj.pending = false;
+
+    sysDebounceObj.timer = xTimerCreateStatic("debounce",
+                                              pdMS_TO_TICKS(SYS_DEBOUNCE_SAMPLE_MS),
+                                              pdTRUE,
+                                              NULL,
+                                              SYS_DEBOUNCE_TimerCallback,
+                                              &sysDebounceObj.timerObj);
+    if (sysDebounceObj.timer == NULL)
+    {
+        return false;
+    }
+
+    sysDebounceObj.running = continuous;
+    if (continuous == true)
+    {
+        return (xTimerStart(sysDebounceObj.timer, 0) == pdPASS);
+    }
+
+    return true;
+}
+
+uint32_t SYS_DEBOUNCE_InputAdd( const SYS_DEBOUNCE_INPUT *input )
+{
+    uint32_t index = sysDebounceObj.count;
+    uint32_t mask;
+
+    if (index >= SYS_DEBOUNCE_MAX_INPUTS)
+    {
+        return SYS_DEBOUNCE_INPUT_NONE;
+    }
+
+    configASSERT((input->pin >> 4U) < SYS_DEBOUNCE_PORT_COUNT);
+
+    mask = 1UL << index;
+    sysDebounceObj.input[index] = *input;
+    sysDebounceObj.ports |= 1UL << (input->pin >> 4U);
+
+    if (input->pressedLevel == false)
+    {
+        sysDebounceObj.activeLow |= mask;
+    }
+    if (GPIO_PinRead(input->pin) == input->pressedLevel)
+    {
+        sysDebounceObj.state |= mask;
+    }
+
+    sysDebounceObj.count = index + 1U;
+
+    return index;
+}
+
+void SYS_DEBOUNCE_WakeFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSavedStatus;
+    bool start = false;
+
+    uxSavedStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    sysDebounceObj.pending = true;
+    if (sysDebounceObj.running == false)
+    {
+        sysDebounceObj.running = true;
+        start = true;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedStatus);
+
+    /* A full timer queue leaves the timer stopped, the next notice retries */
+    if ((start == true) && (xTimerStartFromISR(sysDebounceObj.timer, pxHigherPriorityTaskWoken) != pdPASS))
+    {
+        sysDebounceObj.running = false;
+    }
+}
+
+bool SYS_DEBOUNCE_IsPressed( uint32_t index )
+{
+    if (index >= sysDebounceObj.count)
+    {
+        return false;
+    }
+
+    return ((sysDebounceObj.state & (1UL << index)) != 0U);
+}
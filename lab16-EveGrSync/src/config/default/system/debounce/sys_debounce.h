@@ -0,0 +1,171 @@
+/*******************************************************************************
+  System Input Debounce Service
+
+  File Name:
+    sys_debounce.h
+
+  Summary:
+    Debounces many GPIO inputs with one software timer.
+
+  Description:
+    A one-shot timer per button, restarted by every bounce, costs a timer
+    command from the interrupt for each edge of the bounce and a timer per
+    input, and the level is only looked at once at the end.
+
+    This service samples all registered inputs from a single periodic timer.
+    The inputs are packed one bit each into a word and filtered together by
+    2 bit vertical counters: an input changes its debounced state after
+    four samples in a row that differ from it, any sample that agrees starts
+    the count again.  The filter is a handful of logic operations whatever
+    the number of inputs, up to SYS_DEBOUNCE_MAX_INPUTS.
+
+    Debounced presses and releases are reported by setting bits in an event
+    group, by a notification to a task with eSetBits, or both.
+
+    With tickless idle a timer that runs all the time would wake the core
+    every sample.  A change notice interrupt of any input therefore calls
+    SYS_DEBOUNCE_WakeFromISR, which starts the timer, and the timer stops
+    itself once every input has settled.  Inputs without an interrupt are
+    handled by initializing the service for continuous sampling.
+*******************************************************************************/
+
+#ifndef SYS_DEBOUNCE_H
+#define SYS_DEBOUNCE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "peripheral/gpio/plib_gpio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Inputs that can be registered, one bit of a word each. */
+#ifndef SYS_DEBOUNCE_MAX_INPUTS
+    #define SYS_DEBOUNCE_MAX_INPUTS     (32U)
+#endif
+
+/* Sample period.  An input is debounced after 4 equal samples. */
+#ifndef SYS_DEBOUNCE_SAMPLE_MS
+    #define SYS_DEBOUNCE_SAMPLE_MS      (10U)
+#endif
+
+/* Notification index used for tasks told about edges. */
+#ifndef SYS_DEBOUNCE_NOTIFY_INDEX
+    #define SYS_DEBOUNCE_NOTIFY_INDEX   (0U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Returned by SYS_DEBOUNCE_InputAdd when the table is full. */
+#define SYS_DEBOUNCE_INPUT_NONE         (0xFFFFFFFFU)
+
+/* One input as registered by the application. */
+typedef struct
+{
+    GPIO_PIN pin;
+
+    /* Pin level while the input is pressed */
+    bool pressedLevel;
+
+    /* Set on a debounced press and release, 0 to not report that edge */
+    uint32_t pressBits;
+    uint32_t releaseBits;
+
+    /* Receivers of the bits, either or both may be NULL */
+    EventGroupHandle_t eventGroup;
+    TaskHandle_t task;
+
+} SYS_DEBOUNCE_INPUT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_DEBOUNCE_Initialize( bool continuous )
+
+  Summary:
+    Creates the sample timer.
+
+  Description:
+    With continuous false the timer only runs between a call to
+    SYS_DEBOUNCE_WakeFromISR and the time all inputs have settled, so every
+    input needs a change notice interrupt.  With continuous true it runs
+    from the start of the scheduler on.  Returns false if the timer cannot
+    be created.
+*/
+bool SYS_DEBOUNCE_Initialize( bool continuous );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_DEBOUNCE_InputAdd( const SYS_DEBOUNCE_INPUT *input )
+
+  Summary:
+    Registers an input, returns its index.
+
+  Description:
+    Called before the scheduler starts.  The input is copied and its current
+    level is taken as its debounced state, so registering does not report an
+    edge.  Returns SYS_DEBOUNCE_INPUT_NONE if SYS_DEBOUNCE_MAX_INPUTS are
+    registered already.
+*/
+uint32_t SYS_DEBOUNCE_InputAdd( const SYS_DEBOUNCE_INPUT *input );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DEBOUNCE_WakeFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+
+  Summary:
+    Starts sampling after a change notice.
+
+  Description:
+    Called from the pin interrupt of any registered input.  Cheap when the
+    timer runs already, so every bounce may call it.
+*/
+void SYS_DEBOUNCE_WakeFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_DEBOUNCE_IsPressed( uint32_t index )
+
+  Summary:
+    Debounced state of an input.
+*/
+bool SYS_DEBOUNCE_IsPressed( uint32_t index );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DEBOUNCE_H
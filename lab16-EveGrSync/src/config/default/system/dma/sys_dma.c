@@ -0,0 +1,321 @@
+/*******************************************************************************
+  System DMA Channel Manager
+
+  File Name:
+    sys_dma.c
+
+  Summary:
+    Run time allocation of the DMAC channels and per channel transfer queues.
+
+  Description:
+    Each channel has a small ring of descriptors.  The entry at tail is the
+    one on the channel while active is set; the completion handler retires
+    it, starts the next one and only then calls the client, so the channel
+    idles for as short as possible between queued transfers.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_dma.h"
+
+#if ((SYS_DMA_QUEUE_DEPTH & (SYS_DMA_QUEUE_DEPTH - 1U)) != 0U)
+    #error SYS_DMA_QUEUE_DEPTH must be a power of two
+#endif
+
+#if (SYS_DMA_CHANNEL_COUNT > DMAC_NUMBER_OF_CHANNELS)
+    #error SYS_DMA_CHANNEL_COUNT exceeds the DMAC channels
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_DMA_QUEUE_MASK          (SYS_DMA_QUEUE_DEPTH - 1U)
+
+typedef struct
+{
+    DMAC_DESCRIPTOR descriptor;
+    DMAC_CHANNEL_CALLBACK callback;
+    uintptr_t context;
+
+} SYS_DMA_REQUEST;
+
+typedef struct
+{
+    bool allocated;
+
+    /* true while queue[tail] is on the channel */
+    bool active;
+
+    uint32_t head;
+    uint32_t tail;
+    SYS_DMA_REQUEST queue[SYS_DMA_QUEUE_DEPTH];
+
+    SYS_DMA_CHANNEL_STATISTICS stats;
+
+} SYS_DMA_CHANNEL_OBJECT;
+
+static SYS_DMA_CHANNEL_OBJECT sysDmaChannelObj[SYS_DMA_CHANNEL_COUNT];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static UBaseType_t SYS_DMA_Lock( void )
+{
+    UBaseType_t status = 0U;
+
+    if (uxInterruptNesting != 0U)
+    {
+        status = taskENTER_CRITICAL_FROM_ISR();
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+    }
+
+    return status;
+}
+
+static void SYS_DMA_Unlock( UBaseType_t status )
+{
+    if (uxInterruptNesting != 0U)
+    {
+        taskEXIT_CRITICAL_FROM_ISR(status);
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+
+/* Called locked with the channel idle, starts queue[tail] if there is one. */
+static void SYS_DMA_StartNext( DMAC_CHANNEL channel )
+{
+    SYS_DMA_CHANNEL_OBJECT *chanObj = &sysDmaChannelObj[channel];
+
+    chanObj->active = false;
+
+    while ((chanObj->active == false) && (chanObj->tail != chanObj->head))
+    {
+        const DMAC_DESCRIPTOR *descriptor = &chanObj->queue[chanObj->tail & SYS_DMA_QUEUE_MASK].descriptor;
+
+        chanObj->active = DMAC_ChannelTransfer(channel,
+                                               descriptor->srcAddr, descriptor->srcSize,
+                                               descriptor->destAddr, descriptor->destSize,
+                                               descriptor->cellSize);
+        if (chanObj->active == false)
+        {
+            /* Channel was taken behind our back, drop the request */
+            chanObj->stats.errors++;
+            chanObj->tail++;
+        }
+    }
+}
+
+static void SYS_DMA_EventHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    DMAC_CHANNEL channel = (DMAC_CHANNEL)context;
+    SYS_DMA_CHANNEL_OBJECT *chanObj = &sysDmaChannelObj[channel];
+    DMAC_CHANNEL_CALLBACK callback;
+    uintptr_t clientContext;
+    UBaseType_t lockStatus;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) == 0U)
+    {
+        return;
+    }
+
+    lockStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    if (chanObj->active == false)
+    {
+        /* Released while the transfer was running */
+        taskEXIT_CRITICAL_FROM_ISR(lockStatus);
+        return;
+    }
+
+    {
+        const SYS_DMA_REQUEST *request = &chanObj->queue[chanObj->tail & SYS_DMA_QUEUE_MASK];
+
+        callback = request->callback;
+        clientContext = request->context;
+
+        if (event == DMAC_TRANSFER_EVENT_COMPLETE)
+        {
+            chanObj->stats.transfers++;
+            chanObj->stats.bytes += (uint32_t)((request->descriptor.srcSize > request->descriptor.destSize) ?
+                                               request->descriptor.srcSize : request->descriptor.destSize);
+        }
+        else
+        {
+            chanObj->stats.errors++;
+        }
+    }
+
+    chanObj->tail++;
+    SYS_DMA_StartNext(channel);
+
+    taskEXIT_CRITICAL_FROM_ISR(lockStatus);
+
+    if (callback != NULL)
+    {
+        callback(event, clientContext);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_DMA_Initialize( void )
+{
+    uint32_t i;
+
+    for (i = 0U; i < SYS_DMA_CHANNEL_COUNT; i++)
+    {
+        sysDmaChannelObj[i].allocated = false;
+        sysDmaChannelObj[i].active = false;
+        sysDmaChannelObj[i].head = 0U;
+        sysDmaChannelObj[i].tail = 0U;
+    }
+}
+
+DMAC_CHANNEL SYS_DMA_ChannelAllocate( DMAC_CHANNEL_PRIORITY priority, uint32_t startIrq )
+{
+    DMAC_CHANNEL channel = SYS_DMA_CHANNEL_NONE;
+    UBaseType_t lockStatus = SYS_DMA_Lock();
+    uint32_t i;
+
+    for (i = 0U; i < SYS_DMA_CHANNEL_COUNT; i++)
+    {
+        if (sysDmaChannelObj[i].allocated == false)
+        {
+            sysDmaChannelObj[i].allocated = true;
+            channel = i;
+            break;
+        }
+    }
+
+    SYS_DMA_Unlock(lockStatus);
+
+    if (channel != SYS_DMA_CHANNEL_NONE)
+    {
+        SYS_DMA_CHANNEL_OBJECT *chanObj = &sysDmaChannelObj[channel];
+
+        chanObj->active = false;
+        chanObj->head = 0U;
+        chanObj->tail = 0U;
+        chanObj->stats.transfers = 0U;
+        chanObj->stats.errors = 0U;
+        chanObj->stats.bytes = 0U;
+        chanObj->stats.rejected = 0U;
+        chanObj->stats.queueHighWater = 0U;
+
+        DMAC_ChannelDisable(channel);
+        DMAC_ChannelPrioritySet(channel, priority);
+        DMAC_ChannelStartIrqSet(channel, (startIrq != SYS_DMA_START_IRQ_NONE), startIrq);
+        DMAC_ChannelCallbackRegister(channel, NULL, 0);
+    }
+
+    return channel;
+}
+
+void SYS_DMA_ChannelRelease( DMAC_CHANNEL channel )
+{
+    UBaseType_t lockStatus;
+
+    if (channel >= SYS_DMA_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    DMAC_ChannelDisable(channel);
+    DMAC_ChannelCallbackRegister(channel, NULL, 0);
+
+    lockStatus = SYS_DMA_Lock();
+
+    sysDmaChannelObj[channel].active = false;
+    sysDmaChannelObj[channel].head = 0U;
+    sysDmaChannelObj[channel].tail = 0U;
+    sysDmaChannelObj[channel].allocated = false;
+
+    SYS_DMA_Unlock(lockStatus);
+}
+
+bool SYS_DMA_ChannelTransferAdd( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptor,
+                                 DMAC_CHANNEL_CALLBACK callback, uintptr_t context )
+{
+    SYS_DMA_CHANNEL_OBJECT *chanObj;
+    UBaseType_t lockStatus;
+    bool status = false;
+    uint32_t pending;
+
+    if ((channel >= SYS_DMA_CHANNEL_COUNT) || (sysDmaChannelObj[channel].allocated == false))
+    {
+        return false;
+    }
+
+    chanObj = &sysDmaChannelObj[channel];
+
+    lockStatus = SYS_DMA_Lock();
+
+    if ((chanObj->head - chanObj->tail) < SYS_DMA_QUEUE_DEPTH)
+    {
+        SYS_DMA_REQUEST *request = &chanObj->queue[chanObj->head & SYS_DMA_QUEUE_MASK];
+
+        request->descriptor = *descriptor;
+        request->callback = callback;
+        request->context = context;
+        chanObj->head++;
+
+        pending = chanObj->head - chanObj->tail;
+        if (pending > chanObj->stats.queueHighWater)
+        {
+            chanObj->stats.queueHighWater = pending;
+        }
+
+        if (chanObj->active == false)
+        {
+            DMAC_ChannelCallbackRegister(channel, SYS_DMA_EventHandler, (uintptr_t)channel);
+            SYS_DMA_StartNext(channel);
+        }
+
+        status = true;
+    }
+    else
+    {
+        chanObj->stats.rejected++;
+    }
+
+    SYS_DMA_Unlock(lockStatus);
+
+    return status;
+}
+
+void SYS_DMA_ChannelStatisticsGet( DMAC_CHANNEL channel, SYS_DMA_CHANNEL_STATISTICS *stats )
+{
+    UBaseType_t lockStatus;
+
+    if (channel >= SYS_DMA_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    lockStatus = SYS_DMA_Lock();
+    *stats = sysDmaChannelObj[channel].stats;
+    SYS_DMA_Unlock(lockStatus);
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************
+  System DMA Channel Manager
+
+  File Name:
+    sys_dma.h
+
+  Summary:
+    Run time allocation of the DMAC channels and per channel transfer queues.
+
+  Description:
+    Clients ask for a channel with a priority (DCHxCON.CHPRI) and a start
+    interrupt (DCHxECON.CHSIRQ) instead of relying on one channel fixed by
+    DMAC_Initialize.  A client can either drive its channel directly with the
+    DMAC plib, or queue transfers through SYS_DMA_ChannelTransferAdd: queued
+    transfers are started one after the other from the channel interrupt, so
+    several producers can share one peripheral without a mutex.
+
+    The pool covers the channels the DMAC plib has interrupt vectors for,
+    SYS_DMA_CHANNEL_COUNT, starting at DMAC_CHANNEL_0.
+*******************************************************************************/
+
+#ifndef SYS_DMA_H
+#define SYS_DMA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "peripheral/dmac/plib_dmac.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Channels managed, must not exceed the channels with vectors in the plib. */
+#ifndef SYS_DMA_CHANNEL_COUNT
+    #define SYS_DMA_CHANNEL_COUNT       (4U)
+#endif
+
+/* Pending transfers per channel, must be a power of two. */
+#ifndef SYS_DMA_QUEUE_DEPTH
+    #define SYS_DMA_QUEUE_DEPTH         (4U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Returned by SYS_DMA_ChannelAllocate when every channel is taken */
+#define SYS_DMA_CHANNEL_NONE            (0xFFFFFFFFU)
+
+/* Start interrupt for channels started by software */
+#define SYS_DMA_START_IRQ_NONE          (0xFFFFFFFFU)
+
+typedef struct
+{
+    /* Queued transfers completed and failed */
+    uint32_t transfers;
+    uint32_t errors;
+
+    /* Bytes moved by completed queued transfers */
+    uint32_t bytes;
+
+    /* Transfers rejected because the queue was full */
+    uint32_t rejected;
+
+    /* Highest number of transfers waiting at once */
+    uint32_t queueHighWater;
+
+} SYS_DMA_CHANNEL_STATISTICS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_Initialize( void )
+
+  Summary:
+    Marks every managed channel free.  Call once after SYS_Initialize.
+*/
+void SYS_DMA_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    DMAC_CHANNEL SYS_DMA_ChannelAllocate( DMAC_CHANNEL_PRIORITY priority, uint32_t startIrq )
+
+  Summary:
+    Takes a free channel and programs its priority and start interrupt.
+
+  Description:
+    startIrq is an INT_SOURCE_xxx vector number that starts each cell, or
+    SYS_DMA_START_IRQ_NONE for memory to memory transfers.  The channel's
+    callback is left to the client; SYS_DMA_ChannelTransferAdd registers its
+    own.
+
+  Returns:
+    The channel, or SYS_DMA_CHANNEL_NONE if none is free.
+*/
+DMAC_CHANNEL SYS_DMA_ChannelAllocate( DMAC_CHANNEL_PRIORITY priority, uint32_t startIrq );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_ChannelRelease( DMAC_CHANNEL channel )
+
+  Summary:
+    Disables the channel, drops its queued transfers and returns it to the pool.
+*/
+void SYS_DMA_ChannelRelease( DMAC_CHANNEL channel );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_DMA_ChannelTransferAdd( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptor,
+                                     DMAC_CHANNEL_CALLBACK callback, uintptr_t context )
+
+  Summary:
+    Starts the transfer, or queues it behind the one in progress.
+
+  Description:
+    The descriptor is copied, the buffer it points to must stay valid (and
+    be cache clean) until callback.  callback may be NULL and is called from
+    the channel interrupt.  Callable from tasks and from interrupts running
+    at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+
+  Returns:
+    false if the queue is full.
+*/
+bool SYS_DMA_ChannelTransferAdd( DMAC_CHANNEL channel, const DMAC_DESCRIPTOR *descriptor,
+                                 DMAC_CHANNEL_CALLBACK callback, uintptr_t context );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_ChannelStatisticsGet( DMAC_CHANNEL channel, SYS_DMA_CHANNEL_STATISTICS *stats )
+
+  Summary:
+    Copies the counters of the queued transfers on channel.
+*/
+void SYS_DMA_ChannelStatisticsGet( DMAC_CHANNEL channel, SYS_DMA_CHANNEL_STATISTICS *stats );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DMA_H
@@ -0,0 +1,102 @@
+/*******************************************************************************
+  System DMA Cache Service
+
+  File Name:
+    sys_dma_cache.c
+
+  Summary:
+    Cache-line safe DMA buffers and the cache maintenance they need.
+
+  Description:
+    The cache plib has no write back only operation: CACHE_DataCacheClean
+    (DCACHE_CLEAN_BY_ADDR) writes back and invalidates, CACHE_DataCacheInvalidate
+    (DCACHE_INVALIDATE_BY_ADDR) drops lines without writing them.  Write back
+    plus invalidate is always safe on a shared line, a plain invalidate is
+    only safe on lines the buffer owns, which is why the DMAC-writes
+    directions insist on an aligned buffer.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "device.h"
+#include "device_cache.h"
+#include "peripheral/cache/plib_cache.h"
+#include "FreeRTOS.h"
+#include "sys_dma_cache.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_DMA_CACHE_SEGMENT_MASK      (0xE0000000U)
+#define SYS_DMA_CACHE_KSEG1_BASE        (0xA0000000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_DMA_CacheIsCoherent( const void *buffer )
+{
+    return (((uint32_t)buffer & SYS_DMA_CACHE_SEGMENT_MASK) == SYS_DMA_CACHE_KSEG1_BASE);
+}
+
+void SYS_DMA_CachePrepare( const void *buffer, size_t size, SYS_DMA_CACHE_DIRECTION direction )
+{
+    uint32_t addr = (uint32_t)buffer;
+
+    if ((size == 0U) || (SYS_DMA_CacheIsCoherent(buffer) == true))
+    {
+        return;
+    }
+
+    if (direction != SYS_DMA_CACHE_TO_DEVICE)
+    {
+        configASSERT((addr & (SYS_DMA_CACHE_LINE_SIZE - 1U)) == 0U);
+        size = SYS_DMA_BUFFER_SIZE(size);
+    }
+
+    if (size >= SYS_DMA_CACHE_WHOLE_THRESHOLD)
+    {
+        DCACHE_CLEAN_INVALIDATE();
+    }
+    else if (direction == SYS_DMA_CACHE_FROM_DEVICE)
+    {
+        DCACHE_INVALIDATE_BY_ADDR(addr, size);
+    }
+    else
+    {
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR(addr, size);
+    }
+}
+
+void SYS_DMA_CacheComplete( const void *buffer, size_t size, SYS_DMA_CACHE_DIRECTION direction )
+{
+    uint32_t addr = (uint32_t)buffer;
+
+    if ((size == 0U) || (direction == SYS_DMA_CACHE_TO_DEVICE) ||
+        (SYS_DMA_CacheIsCoherent(buffer) == true))
+    {
+        return;
+    }
+
+    configASSERT((addr & (SYS_DMA_CACHE_LINE_SIZE - 1U)) == 0U);
+    size = SYS_DMA_BUFFER_SIZE(size);
+
+    if (size >= SYS_DMA_CACHE_WHOLE_THRESHOLD)
+    {
+        /* The buffer lines are clean, writing them back changes nothing */
+        DCACHE_CLEAN_INVALIDATE();
+    }
+    else
+    {
+        DCACHE_INVALIDATE_BY_ADDR(addr, size);
+    }
+}
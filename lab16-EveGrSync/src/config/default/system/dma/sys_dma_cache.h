@@ -0,0 +1,145 @@
+/*******************************************************************************
+  System DMA Cache Service
+
+  File Name:
+    sys_dma_cache.h
+
+  Summary:
+    Cache-line safe DMA buffers and the cache maintenance they need.
+
+  Description:
+    The data cache works on 16 byte lines.  Invalidating a line that the DMA
+    buffer shares with another variable throws away the CPU's writes to that
+    variable, writing it back after the transfer overwrites what the DMAC
+    stored.  Buffers declared with SYS_DMA_BUFFER start on a line and are
+    padded to a whole number of lines, so no other data lives in them.
+
+    SYS_DMA_CachePrepare runs before a transfer starts and
+    SYS_DMA_CacheComplete after it ended, both pick the operation from the
+    direction of the transfer.  Above SYS_DMA_CACHE_WHOLE_THRESHOLD bytes the
+    whole data cache is written back and invalidated by index, which takes a
+    fixed time instead of one operation per line.
+
+    Buffers in KSEG1 bypass the cache and need no maintenance at all, the
+    functions return at once for them.  SYS_DMA_BUFFER_COHERENT places a
+    buffer there.
+*******************************************************************************/
+
+#ifndef SYS_DMA_CACHE_H
+#define SYS_DMA_CACHE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Data cache line size of the PIC32MZ EF. */
+#define SYS_DMA_CACHE_LINE_SIZE         (16U)
+
+/* Ranges from this size up are handled on the whole data cache (16 KB). */
+#ifndef SYS_DMA_CACHE_WHOLE_THRESHOLD
+    #define SYS_DMA_CACHE_WHOLE_THRESHOLD   (16384U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Size of a DMA buffer of at least size bytes, in whole cache lines. */
+#define SYS_DMA_BUFFER_SIZE(size)       ((((size) + SYS_DMA_CACHE_LINE_SIZE) - 1U) & ~(SYS_DMA_CACHE_LINE_SIZE - 1U))
+
+/* Declares a cached DMA buffer, e.g. static uint8_t SYS_DMA_BUFFER(txBuffer, 150); */
+#define SYS_DMA_BUFFER(name, size) \
+    __attribute__ ((aligned (SYS_DMA_CACHE_LINE_SIZE))) name[SYS_DMA_BUFFER_SIZE(size)]
+
+/* Declares a DMA buffer in uncached KSEG1, it must be static or global. */
+#define SYS_DMA_BUFFER_COHERENT(name, size) \
+    __attribute__ ((coherent, aligned (SYS_DMA_CACHE_LINE_SIZE))) name[SYS_DMA_BUFFER_SIZE(size)]
+
+typedef enum
+{
+    /* The DMAC reads the buffer: dirty lines are written back */
+    SYS_DMA_CACHE_TO_DEVICE = 0,
+
+    /* The DMAC writes the buffer: its lines are dropped from the cache */
+    SYS_DMA_CACHE_FROM_DEVICE,
+
+    /* Both, e.g. a buffer transformed in place */
+    SYS_DMA_CACHE_BIDIRECTIONAL
+
+} SYS_DMA_CACHE_DIRECTION;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_CachePrepare( const void *buffer, size_t size,
+                               SYS_DMA_CACHE_DIRECTION direction )
+
+  Summary:
+    Makes memory up to date for a transfer that is about to start.
+
+  Description:
+    A buffer the DMAC writes must start on a cache line, size is rounded up
+    to whole lines; use SYS_DMA_BUFFER for it.  A buffer the DMAC only reads
+    can be anywhere.  Callable from any context.
+*/
+void SYS_DMA_CachePrepare( const void *buffer, size_t size, SYS_DMA_CACHE_DIRECTION direction );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_CacheComplete( const void *buffer, size_t size,
+                                SYS_DMA_CACHE_DIRECTION direction )
+
+  Summary:
+    Makes the data a finished transfer wrote visible to the CPU.
+
+  Description:
+    Drops any line fetched while the transfer ran, the CPU must not have
+    written the buffer in the meantime.  Nothing to do for TO_DEVICE.
+*/
+void SYS_DMA_CacheComplete( const void *buffer, size_t size, SYS_DMA_CACHE_DIRECTION direction );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_DMA_CacheIsCoherent( const void *buffer )
+
+  Summary:
+    true for an uncached (KSEG1) address.
+*/
+bool SYS_DMA_CacheIsCoherent( const void *buffer );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DMA_CACHE_H
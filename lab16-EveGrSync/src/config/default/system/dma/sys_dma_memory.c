@@ -0,0 +1,228 @@
+/*******************************************************************************
+  System DMA Memory Service
+
+  File Name:
+    sys_dma_memory.c
+
+  Summary:
+    memcpy/memset that hand large buffers to a software started DMAC channel.
+
+  Description:
+    With SIRQEN clear one CFORCE moves one cell, so every chunk is sent as a
+    single cell of up to SYS_DMA_MEMORY_CHUNK bytes.  For memset the source
+    is a 4 byte pattern: the DMAC wraps the shorter of source and
+    destination, so the pattern repeats over the whole destination.
+
+    Requests go through the channel manager queue, several tasks may copy at
+    once and are served in turn.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "device_cache.h"
+#include "peripheral/cache/plib_cache.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_dma.h"
+#include "sys_dma_memory.h"
+
+#if (SYS_DMA_MEMORY_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+    #error SYS_DMA_MEMORY_NOTIFY_INDEX needs a larger configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_DMA_MEMORY_LINE_SIZE    (16U)
+#define SYS_DMA_MEMORY_LINE_MASK    (SYS_DMA_MEMORY_LINE_SIZE - 1U)
+
+/* DCHxSSIZ, DCHxDSIZ and DCHxCSIZ are 16 bit, keep chunks line aligned */
+#define SYS_DMA_MEMORY_CHUNK        (0xFFF0U)
+
+typedef struct
+{
+    TaskHandle_t task;
+    volatile DMAC_TRANSFER_EVENT event;
+
+} SYS_DMA_MEMORY_WAIT;
+
+static DMAC_CHANNEL sysDmaMemoryChannel = SYS_DMA_CHANNEL_NONE;
+static volatile size_t sysDmaMemoryThreshold = SYS_DMA_MEMORY_THRESHOLD;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_DMA_MemoryEventHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    SYS_DMA_MEMORY_WAIT *wait = (SYS_DMA_MEMORY_WAIT *)context;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    wait->event = event;
+    vTaskNotifyGiveIndexedFromISR(wait->task, SYS_DMA_MEMORY_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
+
+static bool SYS_DMA_MemoryUseDma( size_t size )
+{
+    return ((size >= sysDmaMemoryThreshold) &&
+            (sysDmaMemoryChannel != SYS_DMA_CHANNEL_NONE) &&
+            (uxInterruptNesting == 0U) &&
+            (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING));
+}
+
+/* Moves one chunk and waits for it, false if the DMAC did not do it */
+static bool SYS_DMA_MemoryTransfer( void *dst, const void *src, size_t srcSize, size_t size )
+{
+    SYS_DMA_MEMORY_WAIT wait;
+    DMAC_DESCRIPTOR descriptor;
+
+    wait.task = xTaskGetCurrentTaskHandle();
+    wait.event = DMAC_TRANSFER_EVENT_NONE;
+
+    descriptor.srcAddr = src;
+    descriptor.srcSize = srcSize;
+    descriptor.destAddr = dst;
+    descriptor.destSize = size;
+    descriptor.cellSize = size;
+
+    (void)ulTaskNotifyTakeIndexed(SYS_DMA_MEMORY_NOTIFY_INDEX, pdTRUE, 0);
+
+    if (SYS_DMA_ChannelTransferAdd(sysDmaMemoryChannel, &descriptor,
+                                   SYS_DMA_MemoryEventHandler, (uintptr_t)&wait) == false)
+    {
+        return false;
+    }
+
+    (void)ulTaskNotifyTakeIndexed(SYS_DMA_MEMORY_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+    return (wait.event == DMAC_TRANSFER_EVENT_COMPLETE);
+}
+
+/* Splits [dst, dst + size) into the partial lines at both ends and the
+   whole lines between them, returns the size of the head part */
+static size_t SYS_DMA_MemorySplit( const void *dst, size_t size, size_t *body )
+{
+    size_t head = (SYS_DMA_MEMORY_LINE_SIZE - ((uint32_t)dst & SYS_DMA_MEMORY_LINE_MASK)) & SYS_DMA_MEMORY_LINE_MASK;
+
+    if (head > size)
+    {
+        head = size;
+    }
+
+    *body = (size - head) & ~(size_t)SYS_DMA_MEMORY_LINE_MASK;
+
+    return head;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_DMA_MemoryInitialize( void )
+{
+    sysDmaMemoryChannel = SYS_DMA_ChannelAllocate(DMAC_CHANNEL_PRIORITY_0, SYS_DMA_START_IRQ_NONE);
+}
+
+void SYS_DMA_MemoryThresholdSet( size_t size )
+{
+    sysDmaMemoryThreshold = size;
+}
+
+void *SYS_DMA_MemoryCopy( void *dst, const void *src, size_t size )
+{
+    uint8_t *d = (uint8_t *)dst;
+    const uint8_t *s = (const uint8_t *)src;
+    size_t head;
+    size_t body;
+
+    if (SYS_DMA_MemoryUseDma(size) == false)
+    {
+        return memcpy(dst, src, size);
+    }
+
+    head = SYS_DMA_MemorySplit(dst, size, &body);
+
+    (void)memcpy(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    /* Source lines only need writing back, the destination lines are
+       whole and are simply dropped from the cache */
+    DCACHE_CLEAN_BY_ADDR((uint32_t)s, body);
+    DCACHE_INVALIDATE_BY_ADDR((uint32_t)d, body);
+
+    while (body > 0U)
+    {
+        size_t chunk = (body > SYS_DMA_MEMORY_CHUNK) ? SYS_DMA_MEMORY_CHUNK : body;
+
+        if (SYS_DMA_MemoryTransfer(d, s, chunk, chunk) == false)
+        {
+            (void)memcpy(d, s, chunk);
+        }
+
+        d += chunk;
+        s += chunk;
+        size -= chunk;
+        body -= chunk;
+    }
+
+    (void)memcpy(d, s, size);
+
+    return dst;
+}
+
+void *SYS_DMA_MemorySet( void *dst, uint8_t value, size_t size )
+{
+    uint8_t *d = (uint8_t *)dst;
+    uint32_t pattern = (uint32_t)value * 0x01010101U;
+    size_t head;
+    size_t body;
+
+    if (SYS_DMA_MemoryUseDma(size) == false)
+    {
+        return memset(dst, value, size);
+    }
+
+    head = SYS_DMA_MemorySplit(dst, size, &body);
+
+    (void)memset(d, value, head);
+    d += head;
+    size -= head;
+
+    /* The pattern lives on this task's stack, write it out for the DMAC */
+    DCACHE_CLEAN_BY_ADDR((uint32_t)&pattern, sizeof(pattern));
+    DCACHE_INVALIDATE_BY_ADDR((uint32_t)d, body);
+
+    while (body > 0U)
+    {
+        size_t chunk = (body > SYS_DMA_MEMORY_CHUNK) ? SYS_DMA_MEMORY_CHUNK : body;
+
+        if (SYS_DMA_MemoryTransfer(d, &pattern, sizeof(pattern), chunk) == false)
+        {
+            (void)memset(d, value, chunk);
+        }
+
+        d += chunk;
+        size -= chunk;
+        body -= chunk;
+    }
+
+    (void)memset(d, value, size);
+
+    return dst;
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+  System DMA Memory Service
+
+  File Name:
+    sys_dma_memory.h
+
+  Summary:
+    memcpy/memset that hand large buffers to a software started DMAC channel.
+
+  Description:
+    Below the size threshold, from interrupts and before the
+    scheduler runs, the functions simply call memcpy/memset.  Above it, the
+    calling task sleeps on a task notification while the DMAC moves the data,
+    so lower priority tasks get the CPU for the duration of the copy.
+
+    Cache maintenance is done here.  The cache-line aligned middle of the
+    destination is invalidated and moved by DMA; the partial lines at either
+    end are copied by the CPU, so data sharing those lines is never lost.
+*******************************************************************************/
+
+#ifndef SYS_DMA_MEMORY_H
+#define SYS_DMA_MEMORY_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Smallest size worth a DMA transfer and a context switch until
+   SYS_DMA_MemoryThresholdSet gives a measured one. */
+#ifndef SYS_DMA_MEMORY_THRESHOLD
+    #define SYS_DMA_MEMORY_THRESHOLD    (256U)
+#endif
+
+/* Task notification index used to wait for the DMAC, kept off index 0 so
+   it never consumes notifications meant for the application. */
+#ifndef SYS_DMA_MEMORY_NOTIFY_INDEX
+    #define SYS_DMA_MEMORY_NOTIFY_INDEX (1U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_MemoryInitialize( void )
+
+  Summary:
+    Takes a software started channel from the DMA channel manager.
+
+  Description:
+    Call after SYS_DMA_Initialize.  If no channel is free every copy is done
+    by the CPU.
+*/
+void SYS_DMA_MemoryInitialize( void );
+
+// *****************************************************************************
+/* Function:
+    void *SYS_DMA_MemoryCopy( void *dst, const void *src, size_t size )
+
+  Summary:
+    memcpy, by DMA for large buffers.
+
+  Description:
+    The buffers must not overlap and must not be touched by other tasks
+    until the function returns.  May be called from any context.
+
+  Returns:
+    dst
+*/
+void *SYS_DMA_MemoryCopy( void *dst, const void *src, size_t size );
+
+// *****************************************************************************
+/* Function:
+    void *SYS_DMA_MemorySet( void *dst, uint8_t value, size_t size )
+
+  Summary:
+    memset, by DMA for large buffers.
+
+  Returns:
+    dst
+*/
+void *SYS_DMA_MemorySet( void *dst, uint8_t value, size_t size );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DMA_MemoryThresholdSet( size_t size )
+
+  Summary:
+    Sets the smallest size moved by DMA.
+
+  Description:
+    Where DMA starts to beat the CPU depends on the cache state, bus load and
+    clock, so the application can measure it on the target and set it here.
+    0 sends every copy from a task to the DMAC, SIZE_MAX none.
+*/
+void SYS_DMA_MemoryThresholdSet( size_t size );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DMA_MEMORY_H
@@ -0,0 +1,465 @@
+/*******************************************************************************
+  System Log Service
+
+  File Name:
+    sys_log.c
+
+  Summary:
+    Non-blocking UART6 log output driven by one DMAC channel.
+
+  Description:
+    The ring holds SYS_LOG_SEGMENT_COUNT segments indexed by two free running
+    counters.  head is advanced by producers when they reserve segments, tail
+    is advanced by the DMAC callback when a run of segments has left the
+    channel.
+    Each segment walks FREE -> WRITING -> READY -> IN_FLIGHT -> FREE.
+
+    Only the index bookkeeping is done with interrupts masked; copying,
+    formatting and the cache clean all happen outside the critical section,
+    so the masked window is a handful of instructions per message.
+    Segments are always sent in reservation order: a READY segment waits
+    behind an older one that is still being written.
+
+    Without a DMAC channel the producer writes its segments to UART6 itself,
+    polling UTXBF, and publishes them empty so the ring only tracks order.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include <stdio.h>
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "system/dma/sys_dma.h"
+#include "system/dma/sys_dma_cache.h"
+#include "sys_log.h"
+
+#if ((SYS_LOG_SEGMENT_COUNT & (SYS_LOG_SEGMENT_COUNT - 1U)) != 0U)
+    #error SYS_LOG_SEGMENT_COUNT must be a power of two
+#endif
+
+#if ((SYS_LOG_SEGMENT_SIZE % 16U) != 0U)
+    #error SYS_LOG_SEGMENT_SIZE must be a multiple of the cache line size
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_LOG_SEGMENT_MASK        (SYS_LOG_SEGMENT_COUNT - 1U)
+
+#define SYS_LOG_SEGMENT_FREE        (0U)
+#define SYS_LOG_SEGMENT_WRITING     (1U)
+#define SYS_LOG_SEGMENT_READY       (2U)
+#define SYS_LOG_SEGMENT_IN_FLIGHT   (3U)
+
+/* Polls of the channel in SYS_LOG_Halt, comfortably more than one full
+   segment at 115200 baud */
+#define SYS_LOG_HALT_TIMEOUT        (2000000U)
+
+typedef struct
+{
+    DMAC_CHANNEL channel;
+
+    /* Free running, a segment index is (counter & SYS_LOG_SEGMENT_MASK) */
+    uint32_t head;
+    uint32_t tail;
+
+    /* true while segments are owned by the DMAC */
+    bool busy;
+
+    /* Segments handed to the DMAC in the running linked list transfer */
+    uint32_t inFlight;
+
+    /* Set by SYS_LOG_Halt, nothing is accepted afterwards */
+    bool halted;
+
+    uint32_t dropped;
+
+    uint16_t length[SYS_LOG_SEGMENT_COUNT];
+    uint8_t state[SYS_LOG_SEGMENT_COUNT];
+
+} SYS_LOG_OBJECT;
+
+static volatile SYS_LOG_OBJECT sysLogObj;
+
+static uint8_t SYS_DMA_BUFFER(sysLogSegment[SYS_LOG_SEGMENT_COUNT], SYS_LOG_SEGMENT_SIZE);
+
+/* One descriptor per in flight segment, owned by the DMAC while busy */
+static DMAC_DESCRIPTOR sysLogDescriptor[SYS_LOG_SEGMENT_COUNT];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static UBaseType_t SYS_LOG_Lock( bool fromISR )
+{
+    UBaseType_t status = 0U;
+
+    if (fromISR == true)
+    {
+        status = taskENTER_CRITICAL_FROM_ISR();
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+    }
+
+    return status;
+}
+
+static void SYS_LOG_Unlock( bool fromISR, UBaseType_t status )
+{
+    if (fromISR == true)
+    {
+        taskEXIT_CRITICAL_FROM_ISR(status);
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+
+/* Fallback when no DMAC channel was given, keeps the 8 deep FIFO topped up */
+static void SYS_LOG_PolledWrite( const uint8_t *buffer, size_t size )
+{
+    while (size > 0U)
+    {
+        while ((U6STA & _U6STA_UTXBF_MASK) != 0U)
+        {
+            /* Wait for room in the FIFO */
+        }
+
+        U6TXREG = *buffer;
+        buffer++;
+        size--;
+    }
+}
+
+/* Called with the ring locked and the channel idle.  Retires empty segments
+   and hands every ready segment from the tail on to the DMAC as one linked
+   list transfer, so the completion handler runs once for the whole run. */
+static void SYS_LOG_StartNext( void )
+{
+    uint32_t count = 0U;
+
+    while ((sysLogObj.tail + count) != sysLogObj.head)
+    {
+        uint32_t index = (sysLogObj.tail + count) & SYS_LOG_SEGMENT_MASK;
+
+        if (sysLogObj.state[index] != SYS_LOG_SEGMENT_READY)
+        {
+            /* Segment is still being written, its producer kicks us */
+            break;
+        }
+
+        if ((sysLogObj.length[index] == 0U) && (count == 0U))
+        {
+            sysLogObj.state[index] = SYS_LOG_SEGMENT_FREE;
+            sysLogObj.tail++;
+        }
+        else if (sysLogObj.length[index] == 0U)
+        {
+            /* Retired with the run in front of it */
+            break;
+        }
+        else
+        {
+            sysLogObj.state[index] = SYS_LOG_SEGMENT_IN_FLIGHT;
+            sysLogDescriptor[count].srcAddr = (const void *)sysLogSegment[index];
+            sysLogDescriptor[count].srcSize = sysLogObj.length[index];
+            sysLogDescriptor[count].destAddr = (const void *)&U6TXREG;
+            sysLogDescriptor[count].destSize = 1U;
+            sysLogDescriptor[count].cellSize = 1U;
+            count++;
+        }
+    }
+
+    sysLogObj.inFlight = count;
+    sysLogObj.busy = (count != 0U) &&
+                     DMAC_ChannelLinkedListTransfer(sysLogObj.channel, sysLogDescriptor, count);
+
+    if ((count != 0U) && (sysLogObj.busy == false))
+    {
+        /* The DMAC refused the run, no completion will retire it.  Free the
+           segments and count them as dropped so the ring keeps draining. */
+        while (sysLogObj.inFlight != 0U)
+        {
+            sysLogObj.state[sysLogObj.tail & SYS_LOG_SEGMENT_MASK] = SYS_LOG_SEGMENT_FREE;
+            sysLogObj.tail++;
+            sysLogObj.inFlight--;
+            sysLogObj.dropped++;
+        }
+    }
+}
+
+static bool SYS_LOG_Reserve( uint32_t count, uint32_t *first, bool fromISR )
+{
+    bool status = false;
+    UBaseType_t lockStatus = SYS_LOG_Lock(fromISR);
+
+    if ((sysLogObj.halted == false) &&
+        (((sysLogObj.head - sysLogObj.tail) + count) <= SYS_LOG_SEGMENT_COUNT))
+    {
+        uint32_t i;
+
+        *first = sysLogObj.head;
+        for (i = 0U; i < count; i++)
+        {
+            sysLogObj.state[(sysLogObj.head + i) & SYS_LOG_SEGMENT_MASK] = SYS_LOG_SEGMENT_WRITING;
+        }
+        sysLogObj.head += count;
+        status = true;
+    }
+    else
+    {
+        sysLogObj.dropped++;
+    }
+
+    SYS_LOG_Unlock(fromISR, lockStatus);
+
+    return status;
+}
+
+static void SYS_LOG_Publish( uint32_t first, uint32_t count, bool fromISR )
+{
+    UBaseType_t lockStatus;
+    uint32_t i;
+
+    /* Push the payload out to RAM before the DMAC reads it.  Segments start
+       on a cache line and own every line they span.  Without a channel the
+       payload is written out here and the segment is retired empty. */
+    for (i = 0U; i < count; i++)
+    {
+        uint32_t index = (first + i) & SYS_LOG_SEGMENT_MASK;
+
+        if (sysLogObj.length[index] == 0U)
+        {
+            /* Nothing to send */
+        }
+        else if (sysLogObj.channel == SYS_DMA_CHANNEL_NONE)
+        {
+            SYS_LOG_PolledWrite(sysLogSegment[index], sysLogObj.length[index]);
+            sysLogObj.length[index] = 0U;
+        }
+        else
+        {
+            SYS_DMA_CachePrepare(sysLogSegment[index], sysLogObj.length[index], SYS_DMA_CACHE_TO_DEVICE);
+        }
+    }
+
+    lockStatus = SYS_LOG_Lock(fromISR);
+
+    for (i = 0U; i < count; i++)
+    {
+        sysLogObj.state[(first + i) & SYS_LOG_SEGMENT_MASK] = SYS_LOG_SEGMENT_READY;
+    }
+
+    if ((sysLogObj.busy == false) && (sysLogObj.halted == false))
+    {
+        SYS_LOG_StartNext();
+    }
+
+    SYS_LOG_Unlock(fromISR, lockStatus);
+}
+
+static bool SYS_LOG_WriteInternal( const void *buffer, size_t size, bool fromISR )
+{
+    const uint8_t *src = (const uint8_t *)buffer;
+    uint32_t count;
+    uint32_t first = 0U;
+    uint32_t i;
+
+    if ((buffer == NULL) || (size == 0U))
+    {
+        return true;
+    }
+
+    count = (uint32_t)((size + SYS_LOG_SEGMENT_SIZE - 1U) / SYS_LOG_SEGMENT_SIZE);
+
+    if (SYS_LOG_Reserve(count, &first, fromISR) == false)
+    {
+        return false;
+    }
+
+    for (i = 0U; i < count; i++)
+    {
+        uint32_t index = (first + i) & SYS_LOG_SEGMENT_MASK;
+        size_t chunk = (size > SYS_LOG_SEGMENT_SIZE) ? SYS_LOG_SEGMENT_SIZE : size;
+
+        (void)memcpy(sysLogSegment[index], src, chunk);
+        sysLogObj.length[index] = (uint16_t)chunk;
+
+        src += chunk;
+        size -= chunk;
+    }
+
+    SYS_LOG_Publish(first, count, fromISR);
+
+    return true;
+}
+
+static void SYS_LOG_DmaHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    UBaseType_t lockStatus;
+
+    (void)context;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) == 0U)
+    {
+        return;
+    }
+
+    lockStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    while (sysLogObj.inFlight != 0U)
+    {
+        sysLogObj.state[sysLogObj.tail & SYS_LOG_SEGMENT_MASK] = SYS_LOG_SEGMENT_FREE;
+        sysLogObj.tail++;
+        sysLogObj.inFlight--;
+    }
+
+    if (sysLogObj.halted == false)
+    {
+        SYS_LOG_StartNext();
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(lockStatus);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_LOG_Initialize( DMAC_CHANNEL channel )
+{
+    uint32_t i;
+
+    sysLogObj.channel = channel;
+    sysLogObj.head = 0U;
+    sysLogObj.tail = 0U;
+    sysLogObj.busy = false;
+    sysLogObj.inFlight = 0U;
+    sysLogObj.halted = false;
+    sysLogObj.dropped = 0U;
+
+    for (i = 0U; i < SYS_LOG_SEGMENT_COUNT; i++)
+    {
+        sysLogObj.length[i] = 0U;
+        sysLogObj.state[i] = SYS_LOG_SEGMENT_FREE;
+    }
+
+    if (channel == SYS_DMA_CHANNEL_NONE)
+    {
+        return false;
+    }
+
+    DMAC_ChannelCallbackRegister(channel, SYS_LOG_DmaHandler, 0);
+
+    return true;
+}
+
+bool SYS_LOG_Write( const void *buffer, size_t size )
+{
+    return SYS_LOG_WriteInternal(buffer, size, false);
+}
+
+bool SYS_LOG_WriteFromISR( const void *buffer, size_t size )
+{
+    return SYS_LOG_WriteInternal(buffer, size, true);
+}
+
+bool SYS_LOG_Print( const char *msg )
+{
+    return SYS_LOG_WriteInternal(msg, strlen(msg), false);
+}
+
+bool SYS_LOG_VPrintf( const char *format, va_list args )
+{
+    uint32_t first = 0U;
+    uint32_t index;
+    int length;
+
+    if (SYS_LOG_Reserve(1U, &first, false) == false)
+    {
+        return false;
+    }
+
+    index = first & SYS_LOG_SEGMENT_MASK;
+
+    length = vsnprintf((char *)sysLogSegment[index], SYS_LOG_SEGMENT_SIZE, format, args);
+    if (length < 0)
+    {
+        length = 0;
+    }
+    else if (length >= (int)SYS_LOG_SEGMENT_SIZE)
+    {
+        /* Truncated, drop the terminating NUL from the transfer */
+        length = (int)SYS_LOG_SEGMENT_SIZE - 1;
+    }
+    else
+    {
+        /* Fits */
+    }
+
+    sysLogObj.length[index] = (uint16_t)length;
+
+    SYS_LOG_Publish(first, 1U, false);
+
+    return true;
+}
+
+bool SYS_LOG_Printf( const char *format, ... )
+{
+    bool status;
+    va_list args;
+
+    va_start(args, format);
+    status = SYS_LOG_VPrintf(format, args);
+    va_end(args);
+
+    return status;
+}
+
+uint32_t SYS_LOG_DroppedCountGet( void )
+{
+    return sysLogObj.dropped;
+}
+
+bool SYS_LOG_IsIdle( void )
+{
+    return (sysLogObj.head == sysLogObj.tail);
+}
+
+void SYS_LOG_Halt( void )
+{
+    uint32_t timeout = SYS_LOG_HALT_TIMEOUT;
+
+    sysLogObj.halted = true;
+
+    if (sysLogObj.channel == SYS_DMA_CHANNEL_NONE)
+    {
+        return;
+    }
+
+    /* The DMAC keeps moving bytes with interrupts masked, only the completion
+       handler is held off, so wait on the channel flags themselves */
+    while ((DMAC_ChannelIsBusy(sysLogObj.channel) == true) && (timeout > 0U))
+    {
+        timeout--;
+    }
+
+    DMAC_ChannelDisable(sysLogObj.channel);
+    sysLogObj.busy = false;
+}
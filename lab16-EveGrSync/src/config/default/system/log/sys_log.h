@@ -0,0 +1,172 @@
+/*******************************************************************************
+  System Log Service
+
+  File Name:
+    sys_log.h
+
+  Summary:
+    Non-blocking UART6 log output driven by one DMAC channel.
+
+  Description:
+    Tasks and interrupts reserve one or more DMA-ready segments from a ring,
+    copy or format their message straight into the segment and return at
+    once.  The DMAC channel callback retires the finished segment and starts
+    the next pending one itself, so no task ever waits for the wire time of a
+    message and no shared transmit buffer, mutex or completion semaphore is
+    needed.
+
+    Segments are cache-line aligned and a whole number of cache lines long, so
+    cleaning a segment before the transfer never touches neighbouring data.
+    When the ring is full the message is dropped and counted, the caller is
+    never blocked.
+*******************************************************************************/
+
+#ifndef SYS_LOG_H
+#define SYS_LOG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include "peripheral/dmac/plib_dmac.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of segments in the ring, must be a power of two. */
+#ifndef SYS_LOG_SEGMENT_COUNT
+    #define SYS_LOG_SEGMENT_COUNT       (8U)
+#endif
+
+/* Bytes per segment, must be a multiple of the 16 byte cache line. */
+#ifndef SYS_LOG_SEGMENT_SIZE
+    #define SYS_LOG_SEGMENT_SIZE        (128U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_Initialize( DMAC_CHANNEL channel )
+
+  Summary:
+    Takes over the DMAC channel that feeds U6TXREG.
+
+  Description:
+    Empties the ring and registers the log completion handler on the channel.
+    The channel must already be configured to start on the UART6 transmit
+    interrupt, as SYS_DMA_ChannelAllocate does.  Call once after
+    SYS_Initialize and before any other SYS_LOG function.
+
+  Returns:
+    false if channel is SYS_DMA_CHANNEL_NONE.  The service still works but
+    every message is written to UART6 by polling, in the caller's context.
+*/
+bool SYS_LOG_Initialize( DMAC_CHANNEL channel );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_Write( const void *buffer, size_t size )
+    bool SYS_LOG_WriteFromISR( const void *buffer, size_t size )
+
+  Summary:
+    Queues size bytes for transmission and returns immediately.
+
+  Description:
+    Messages longer than one segment are spread over consecutive segments
+    that are reserved together, so output from different producers never
+    interleaves.  The FromISR variant must be used from interrupt handlers
+    running at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+
+  Returns:
+    true if the message was queued, false if the ring had no room (the
+    message is counted by SYS_LOG_DroppedCountGet).
+*/
+bool SYS_LOG_Write( const void *buffer, size_t size );
+bool SYS_LOG_WriteFromISR( const void *buffer, size_t size );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_Print( const char *msg )
+
+  Summary:
+    SYS_LOG_Write for a NUL terminated string, task context only.
+*/
+bool SYS_LOG_Print( const char *msg );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_Printf( const char *format, ... )
+
+  Summary:
+    Formats directly into a reserved segment, task context only.
+
+  Description:
+    Output longer than SYS_LOG_SEGMENT_SIZE is truncated.
+*/
+bool SYS_LOG_Printf( const char *format, ... ) __attribute__((format(printf, 1, 2)));
+bool SYS_LOG_VPrintf( const char *format, va_list args );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_LOG_DroppedCountGet( void )
+
+  Summary:
+    Number of messages rejected because the ring was full, plus segments
+    freed unsent because the DMAC refused their transfer.
+*/
+uint32_t SYS_LOG_DroppedCountGet( void );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_LOG_IsIdle( void )
+
+  Summary:
+    true when every queued segment has left the DMAC.
+*/
+bool SYS_LOG_IsIdle( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_LOG_Halt( void )
+
+  Summary:
+    Stops the service for good, used on the panic path.
+
+  Description:
+    Lets the segment that is on the wire finish, then disables the channel.
+    Works with interrupts masked.  Segments still waiting in the ring are
+    abandoned and every later write is dropped, leaving UART6 to the caller.
+*/
+void SYS_LOG_Halt( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_LOG_H
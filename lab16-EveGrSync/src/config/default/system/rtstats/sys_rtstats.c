@@ -0,0 +1,166 @@
+/*******************************************************************************
+  System Run Time Statistics Service
+
+  File Name:
+    sys_rtstats.c
+
+  Summary:
+    Per-task and per-interrupt CPU time from the CP0 Count register.
+
+  Description:
+    The upper 32 bits are counted in software: a read that finds Count below
+    the previous read has seen one wrap.  Reads are serialized by masking
+    the kernel interrupts, the kernel itself reads the counter on every
+    context switch.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_rtstats.h"
+
+#if (configGENERATE_RUN_TIME_STATS != 1) || (configUSE_TRACE_FACILITY != 1)
+    #error SYS_RTSTATS needs configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t sysRtStatsLast;
+static uint32_t sysRtStatsHigh;
+
+static uint64_t sysRtStatsIsrTime[SYS_RTSTATS_ISR_COUNT];
+static uint32_t sysRtStatsIsrCount[SYS_RTSTATS_ISR_COUNT];
+
+/* uxTaskGetSystemState output, only touched with the scheduler suspended */
+static TaskStatus_t sysRtStatsTaskStatus[SYS_RTSTATS_MAX_TASKS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_RTSTATS_Initialize( void )
+{
+    sysRtStatsLast = _CP0_GET_COUNT();
+    sysRtStatsHigh = 0U;
+
+    (void)memset(sysRtStatsIsrTime, 0, sizeof(sysRtStatsIsrTime));
+    (void)memset(sysRtStatsIsrCount, 0, sizeof(sysRtStatsIsrCount));
+}
+
+uint64_t SYS_RTSTATS_CounterGet( void )
+{
+    UBaseType_t uxSavedStatus;
+    uint32_t count;
+    uint64_t value;
+
+    uxSavedStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    count = _CP0_GET_COUNT();
+    if (count < sysRtStatsLast)
+    {
+        sysRtStatsHigh++;
+    }
+    sysRtStatsLast = count;
+
+    value = ((uint64_t)sysRtStatsHigh << 32) | count;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedStatus);
+
+    return value;
+}
+
+void SYS_RTSTATS_IsrExit( SYS_RTSTATS_ISR isr, uint32_t start )
+{
+    /* An interrupt never runs for 43 s, the 32 bit difference is enough.
+       Only this handler writes its slot, a nested interrupt has another. */
+    sysRtStatsIsrTime[isr] += (uint32_t)(_CP0_GET_COUNT() - start);
+    sysRtStatsIsrCount[isr]++;
+}
+
+void SYS_RTSTATS_Snapshot( SYS_RTSTATS_SNAPSHOT *snapshot )
+{
+    configRUN_TIME_COUNTER_TYPE total = 0U;
+    UBaseType_t count;
+    UBaseType_t i;
+
+    vTaskSuspendAll();
+    {
+        /* Returns 0 when there are more tasks than SYS_RTSTATS_MAX_TASKS */
+        count = uxTaskGetSystemState(sysRtStatsTaskStatus, SYS_RTSTATS_MAX_TASKS, &total);
+
+        for (i = 0U; i < count; i++)
+        {
+            snapshot->task[i].number = sysRtStatsTaskStatus[i].xTaskNumber;
+            snapshot->task[i].handle = sysRtStatsTaskStatus[i].xHandle;
+            snapshot->task[i].runTime = sysRtStatsTaskStatus[i].ulRunTimeCounter;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    snapshot->time = total;
+    snapshot->taskCount = count;
+
+    /* The 64 bit interrupt counters are not written in one instruction */
+    taskENTER_CRITICAL();
+    (void)memcpy(snapshot->isrTime, sysRtStatsIsrTime, sizeof(snapshot->isrTime));
+    (void)memcpy(snapshot->isrCount, sysRtStatsIsrCount, sizeof(snapshot->isrCount));
+    taskEXIT_CRITICAL();
+}
+
+void SYS_RTSTATS_Diff( const SYS_RTSTATS_SNAPSHOT *before, const SYS_RTSTATS_SNAPSHOT *after,
+                       SYS_RTSTATS_SNAPSHOT *delta )
+{
+    UBaseType_t i;
+    UBaseType_t k;
+    uint32_t isr;
+
+    delta->time = after->time - before->time;
+    delta->taskCount = after->taskCount;
+
+    for (i = 0U; i < after->taskCount; i++)
+    {
+        uint64_t start = 0U;
+
+        for (k = 0U; k < before->taskCount; k++)
+        {
+            if (before->task[k].number == after->task[i].number)
+            {
+                start = before->task[k].runTime;
+                break;
+            }
+        }
+
+        delta->task[i].number = after->task[i].number;
+        delta->task[i].handle = after->task[i].handle;
+        delta->task[i].runTime = after->task[i].runTime - start;
+    }
+
+    for (isr = 0U; isr < (uint32_t)SYS_RTSTATS_ISR_COUNT; isr++)
+    {
+        delta->isrTime[isr] = after->isrTime[isr] - before->isrTime[isr];
+        delta->isrCount[isr] = after->isrCount[isr] - before->isrCount[isr];
+    }
+}
+
+uint32_t SYS_RTSTATS_Permille( uint64_t part, uint64_t total )
+{
+    if (total == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t)(((part * 1000U) + (total / 2U)) / total);
+}
@@ -0,0 +1,199 @@
+/*******************************************************************************
+  System Run Time Statistics Service
+
+  File Name:
+    sys_rtstats.h
+
+  Summary:
+    Per-task and per-interrupt CPU time from the CP0 Count register.
+
+  Description:
+    The core timer counts at SYSCLK / 2 (100 MHz, 10 ns) and wraps every 43
+    seconds.  SYS_RTSTATS_CounterGet extends it to 64 bits and is the run
+    time clock of the kernel (portGET_RUN_TIME_COUNTER_VALUE), so every task
+    accumulates its execution time in a 64 bit counter that does not wrap.
+    The extension only needs a read every 43 seconds, the idle hook makes
+    sure of that.
+
+    Interrupt handlers wrapped in SYS_RTSTATS_IsrEnter / SYS_RTSTATS_IsrExit
+    accumulate their own time.  It is inclusive: an interrupt nested inside
+    another is counted in both.  The time is also part of the task that was
+    interrupted, the kernel does not know about it.
+
+    SYS_RTSTATS_Snapshot copies all counters without formatting anything, two
+    snapshots passed to SYS_RTSTATS_Diff give the load over the interval
+    between them.
+*******************************************************************************/
+
+#ifndef SYS_RTSTATS_H
+#define SYS_RTSTATS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <xc.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Counter ticks per second: the core timer runs at SYSCLK / 2. */
+#define SYS_RTSTATS_COUNTER_HZ          (100000000UL)
+
+/* Tasks a snapshot has room for.  It must cover every task in the system,
+   otherwise uxTaskGetSystemState returns none at all. */
+#ifndef SYS_RTSTATS_MAX_TASKS
+    #define SYS_RTSTATS_MAX_TASKS       (16U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Interrupts with their own counter, one per handler in interrupts.c */
+typedef enum
+{
+    SYS_RTSTATS_ISR_CHANGE_NOTICE_C = 0,
+    SYS_RTSTATS_ISR_CHANGE_NOTICE_J,
+    SYS_RTSTATS_ISR_DMA0,
+    SYS_RTSTATS_ISR_DMA1,
+    SYS_RTSTATS_ISR_DMA2,
+    SYS_RTSTATS_ISR_DMA3,
+
+    SYS_RTSTATS_ISR_COUNT
+
+} SYS_RTSTATS_ISR;
+
+typedef struct
+{
+    /* xTaskNumber, stays unique while the task exists */
+    UBaseType_t number;
+    TaskHandle_t handle;
+    uint64_t runTime;
+
+} SYS_RTSTATS_TASK;
+
+typedef struct
+{
+    /* Counter value when the snapshot was taken, or the length of the
+       interval for a difference */
+    uint64_t time;
+
+    UBaseType_t taskCount;
+    SYS_RTSTATS_TASK task[SYS_RTSTATS_MAX_TASKS];
+
+    uint64_t isrTime[SYS_RTSTATS_ISR_COUNT];
+    uint32_t isrCount[SYS_RTSTATS_ISR_COUNT];
+
+} SYS_RTSTATS_SNAPSHOT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_RTSTATS_Initialize( void )
+
+  Summary:
+    Starts the 64 bit counter, called by the kernel through
+    portCONFIGURE_TIMER_FOR_RUN_TIME_STATS when the scheduler starts.
+*/
+void SYS_RTSTATS_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    uint64_t SYS_RTSTATS_CounterGet( void )
+
+  Summary:
+    Core timer extended to 64 bits, callable from any context.
+*/
+uint64_t SYS_RTSTATS_CounterGet( void );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_RTSTATS_IsrEnter( void )
+    void SYS_RTSTATS_IsrExit( SYS_RTSTATS_ISR isr, uint32_t start )
+
+  Summary:
+    Bracket an interrupt handler to charge its time to isr.
+
+  Description:
+    Only for interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+*/
+static inline uint32_t SYS_RTSTATS_IsrEnter( void )
+{
+    return _CP0_GET_COUNT();
+}
+
+void SYS_RTSTATS_IsrExit( SYS_RTSTATS_ISR isr, uint32_t start );
+
+// *****************************************************************************
+/* Function:
+    void SYS_RTSTATS_Snapshot( SYS_RTSTATS_SNAPSHOT *snapshot )
+
+  Summary:
+    Copies the run time of every task and interrupt.
+
+  Description:
+    Task context only, the scheduler is suspended while the task list is
+    read.  Tasks are in the order of uxTaskGetSystemState.
+*/
+void SYS_RTSTATS_Snapshot( SYS_RTSTATS_SNAPSHOT *snapshot );
+
+// *****************************************************************************
+/* Function:
+    void SYS_RTSTATS_Diff( const SYS_RTSTATS_SNAPSHOT *before,
+                           const SYS_RTSTATS_SNAPSHOT *after,
+                           SYS_RTSTATS_SNAPSHOT *delta )
+
+  Summary:
+    Time used between two snapshots.
+
+  Description:
+    delta gets the tasks of after, a task created in between is charged from
+    zero.  delta may be the same object as after.
+*/
+void SYS_RTSTATS_Diff( const SYS_RTSTATS_SNAPSHOT *before, const SYS_RTSTATS_SNAPSHOT *after,
+                       SYS_RTSTATS_SNAPSHOT *delta );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_RTSTATS_Permille( uint64_t part, uint64_t total )
+
+  Summary:
+    part / total in 0.1 % steps, e.g. a task of a difference over its time.
+*/
+uint32_t SYS_RTSTATS_Permille( uint64_t part, uint64_t total );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_RTSTATS_H
@@ -0,0 +1,166 @@
+/*******************************************************************************
+  System UART Receive Service
+
+  File Name:
+    sys_uart_rx.c
+
+  Summary:
+    Line oriented UART6 receive by DMA with pattern match termination.
+
+  Description:
+    The DMAC does not report how many bytes a pattern terminated block held,
+    but the line ends at the first delimiter in the buffer: nothing before it
+    can be a delimiter or the channel would have stopped there.  A buffer
+    without one was filled completely.
+
+    While the DMAC owns a buffer the CPU does not touch it; it is invalidated
+    before the transfer starts and again before it is read, so no stale line
+    survives in the cache.  The buffers are whole cache lines.
+
+    The 8 byte receive FIFO holds what arrives while the interrupt restarts
+    the channel.  A receiver overrun stops the UART until OERR is cleared,
+    which SYS_UART_RX_LineRead does whenever it is called.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "peripheral/dmac/plib_dmac.h"
+#include "peripheral/evic/plib_evic.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_buffer.h"
+#include "system/dma/sys_dma.h"
+#include "system/dma/sys_dma_cache.h"
+#include "sys_uart_rx.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    DMAC_CHANNEL channel;
+    uint8_t delimiter;
+
+    /* Buffer the DMAC is filling */
+    uint32_t active;
+
+    MessageBufferHandle_t lines;
+
+    volatile uint32_t dropped;
+
+} SYS_UART_RX_OBJECT;
+
+static SYS_UART_RX_OBJECT sysUartRxObj;
+
+static uint8_t SYS_DMA_BUFFER(sysUartRxBuffer[2], SYS_UART_RX_BUFFER_SIZE);
+
+static uint8_t sysUartRxMessageStorage[SYS_UART_RX_MESSAGE_BUFFER_SIZE + 1U];
+static StaticMessageBuffer_t sysUartRxMessageObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_UART_RX_Start( uint32_t index )
+{
+    SYS_DMA_CachePrepare(sysUartRxBuffer[index], SYS_UART_RX_BUFFER_SIZE, SYS_DMA_CACHE_FROM_DEVICE);
+
+    sysUartRxObj.active = index;
+    (void)DMAC_ChannelTransfer(sysUartRxObj.channel,
+                               (const void *)&U6RXREG, 1,
+                               (const void *)sysUartRxBuffer[index], SYS_UART_RX_BUFFER_SIZE,
+                               1);
+}
+
+static void SYS_UART_RX_DmaHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t done = sysUartRxObj.active;
+    const uint8_t *end;
+    size_t length;
+
+    (void)context;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) == 0U)
+    {
+        return;
+    }
+
+    /* Keep the channel going first, the FIFO only covers 8 characters */
+    SYS_UART_RX_Start(done ^ 1U);
+
+    if (event != DMAC_TRANSFER_EVENT_COMPLETE)
+    {
+        sysUartRxObj.dropped++;
+        return;
+    }
+
+    SYS_DMA_CacheComplete(sysUartRxBuffer[done], SYS_UART_RX_BUFFER_SIZE, SYS_DMA_CACHE_FROM_DEVICE);
+
+    end = memchr(sysUartRxBuffer[done], sysUartRxObj.delimiter, SYS_UART_RX_BUFFER_SIZE);
+    length = (end == NULL) ? SYS_UART_RX_BUFFER_SIZE : (size_t)(end - sysUartRxBuffer[done]) + 1U;
+
+    if (xMessageBufferSendFromISR(sysUartRxObj.lines, sysUartRxBuffer[done], length,
+                                  &xHigherPriorityTaskWoken) != length)
+    {
+        sysUartRxObj.dropped++;
+    }
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_UART_RX_Initialize( uint8_t delimiter )
+{
+    sysUartRxObj.channel = SYS_DMA_ChannelAllocate(DMAC_CHANNEL_PRIORITY_2, INT_SOURCE_UART6_RX);
+    if (sysUartRxObj.channel == SYS_DMA_CHANNEL_NONE)
+    {
+        return false;
+    }
+
+    sysUartRxObj.delimiter = delimiter;
+    sysUartRxObj.dropped = 0U;
+    sysUartRxObj.lines = xMessageBufferCreateStatic(sizeof(sysUartRxMessageStorage),
+                                                    sysUartRxMessageStorage,
+                                                    &sysUartRxMessageObj);
+
+    DMAC_ChannelPatternMatchSetup(sysUartRxObj.channel, DMAC_DATA_PATTERN_SIZE_1_BYTE, delimiter);
+    DMAC_ChannelCallbackRegister(sysUartRxObj.channel, SYS_UART_RX_DmaHandler, 0);
+
+    SYS_UART_RX_Start(0U);
+
+    return true;
+}
+
+size_t SYS_UART_RX_LineRead( void *buffer, size_t size, TickType_t timeout )
+{
+    if ((U6STA & _U6STA_OERR_MASK) != 0U)
+    {
+        /* Clearing OERR also flushes the receive FIFO */
+        U6STACLR = _U6STA_OERR_MASK;
+        sysUartRxObj.dropped++;
+    }
+
+    return xMessageBufferReceive(sysUartRxObj.lines, buffer, size, timeout);
+}
+
+uint32_t SYS_UART_RX_DroppedCountGet( void )
+{
+    return sysUartRxObj.dropped;
+}
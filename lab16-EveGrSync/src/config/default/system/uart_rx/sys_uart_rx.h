@@ -0,0 +1,116 @@
+/*******************************************************************************
+  System UART Receive Service
+
+  File Name:
+    sys_uart_rx.h
+
+  Summary:
+    Line oriented UART6 receive by DMA with pattern match termination.
+
+  Description:
+    A DMAC channel started by the UART6 receive interrupt moves each byte
+    from U6RXREG into one of two buffers and stops by itself on the
+    delimiter byte, so the CPU sees one interrupt per line instead of one per
+    character.  The channel interrupt restarts reception into the other
+    buffer before anything else, then copies the finished line into a
+    message buffer that a task reads with SYS_UART_RX_LineRead.
+
+    A line longer than SYS_UART_RX_BUFFER_SIZE is delivered in buffer sized
+    pieces, only the last one ends with the delimiter.
+*******************************************************************************/
+
+#ifndef SYS_UART_RX_H
+#define SYS_UART_RX_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bytes per DMA buffer. */
+#ifndef SYS_UART_RX_BUFFER_SIZE
+    #define SYS_UART_RX_BUFFER_SIZE     (64U)
+#endif
+
+/* Storage of the message buffer between the ISR and the reading task. */
+#ifndef SYS_UART_RX_MESSAGE_BUFFER_SIZE
+    #define SYS_UART_RX_MESSAGE_BUFFER_SIZE (256U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_UART_RX_Initialize( uint8_t delimiter )
+
+  Summary:
+    Takes a DMAC channel started by UART6 RX and starts receiving.
+
+  Description:
+    Call after SYS_DMA_Initialize.  UART6 must be initialized with its
+    receive interrupt left disabled in the EVIC, the DMAC consumes it.
+
+  Returns:
+    false if no DMAC channel was free.
+*/
+bool SYS_UART_RX_Initialize( uint8_t delimiter );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_UART_RX_LineRead( void *buffer, size_t size, TickType_t timeout )
+
+  Summary:
+    Waits for the next line and copies it into buffer.
+
+  Description:
+    One task may read at a time.  buffer should hold at least
+    SYS_UART_RX_BUFFER_SIZE bytes, a longer line is lost otherwise.  The
+    line is not NUL terminated.
+
+  Returns:
+    Number of bytes copied, 0 on timeout.
+*/
+size_t SYS_UART_RX_LineRead( void *buffer, size_t size, TickType_t timeout );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_UART_RX_DroppedCountGet( void )
+
+  Summary:
+    Lines lost because the message buffer was full, plus receiver overruns.
+*/
+uint32_t SYS_UART_RX_DroppedCountGet( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_UART_RX_H
@@ -33,6 +33,8 @@
     This file contains the "main" function for a project.  The "main" function calls the "SYS_Initialize" function to initialize the state
     machines of all modules in the system, and call LAB16_Initialize function to initialize the modules of the application. 
  * Debug messages or notifications are showed via UART6.  DMA module is using to make the task/CPU unblock and transmission continues in background.
+ * At start the Office task checks the CRC service and times memcpy against the DMAC to set the DMA copy threshold.
+ * Every 5 seconds it sends a $LOAD telemetry line with a CRC-16, typing "top" on the console shows the load of every task.
  *******************************************************************************/
 
 // *****************************************************************************
@@ -55,18 +57,40 @@
 #include "semphr.h"
 #include "timers.h"
 #include "event_groups.h"
+#include "system/dma/sys_dma.h"
+#include "system/dma/sys_dma_memory.h"
+#include "system/dma/sys_dma_cache.h"
+#include "system/log/sys_log.h"
+#include "system/crc/sys_crc.h"
+#include "system/console/sys_console.h"
+#include "system/uart_rx/sys_uart_rx.h"
+#include "system/rtstats/sys_rtstats.h"
+#include "system/debounce/sys_debounce.h"
 
 //define constant
 #define KEY_PRESS_STATE	0
-#define DEBOUNCE_PERIOD	50
 #define LED1_BLINKING	500
 #define LED2_BLINKING	2000
 #define LED3_BLINKING	4000
 #define LEDRGB_BLINKING	200
 static TickType_t TICK_TO_WAIT = 100 / portTICK_PERIOD_MS;
 
+//copy sizes swept by the dma memory calibration, doubling from the smallest
+#define COPY_SWEEP_MIN		16
+#define COPY_SWEEP_MAX		4096
+#define COPY_SWEEP_STEPS	9
+//copies timed at each size, the fastest one counts
+#define COPY_SWEEP_ROUNDS	8
+
+//the core timer counts at half the CPU clock
+#define CORE_TIMER_CYCLES(count) ((count) * 2U)
+
+//stacks in words, the Office task runs the crc self test, the copy calibration and the formatted log lines
+//the console input task formats the task loads
+#define OFFICE_TASK_STACK_SIZE	(configMINIMAL_STACK_SIZE * 4)
+#define COM_RX_TASK_STACK_SIZE	(configMINIMAL_STACK_SIZE * 2)
+
 //assign bits for event group
-#define BIT_U6_TX_COMPLETE	(1U << 0)
 #define BIT_SW1_STATE	(1U << 1)
 #define BIT_LED1_SYNC	(1U << 2)
 #define BIT_SW2_STATE	(1U << 3)
@@ -85,18 +109,8 @@ static StaticEventGroup_t xLab16EveGrBuffer;
 
 //declare primitives 
 static SemaphoreHandle_t xMutex;
-
-//declare software timer for debounce 50ms when key pressing
-static TimerHandle_t xDebounceSW1Timer;
-static TimerHandle_t xDebounceSW2Timer;
-static TimerHandle_t xDebounceSW3Timer;
-static TimerHandle_t xDebounceSW4Timer;
-
-//declare debounce timer's buffer
-static StaticTimer_t xDebounceSW1Buffer;
-static StaticTimer_t xDebounceSW2Buffer;
-static StaticTimer_t xDebounceSW3Buffer;
-static StaticTimer_t xDebounceSW4Buffer;
+static SemaphoreHandle_t xStatsMutex;
+static StaticSemaphore_t xStatsMutexBuffer;
 
 //declare interval timers for blinking leds
 static TimerHandle_t xLED1BlinkingTimer;
@@ -129,43 +143,15 @@ static void prvLEDRGBFunc(void * pvParams);
 
 //declare variables and function of greeting task-static
 static StaticTask_t xOfficeTaskBuffer;
-static StackType_t xOfficeTaskStack[configMINIMAL_STACK_SIZE];
+static StackType_t xOfficeTaskStack[OFFICE_TASK_STACK_SIZE];
 static void prvOfficeTaskFunc(void * pvParams);
 
+//declare variables and function of the console input task-static
+static StaticTask_t xComRxTaskBuffer;
+static StackType_t xComRxTaskStack[COM_RX_TASK_STACK_SIZE];
+static void prvComRxFunc(void * pvParams);
 
 
-//declare debounce timer's callbacks
-static void prvDebounceSW1Callback(TimerHandle_t xTimer){
-	if (SW1_Get() == KEY_PRESS_STATE){
-		xEventGroupSetBits(
-			xLab16EveGr,
-			BIT_SW1_STATE | BIT_1ST);//BIT_1ST is only for Office Task
-	}
-}
-
-static void prvDebounceSW2Callback(TimerHandle_t xTimer){
-	if (SW2_Get() == KEY_PRESS_STATE){
-		xEventGroupSetBits(
-			xLab16EveGr,
-			BIT_SW2_STATE | BIT_2ND);//BIT_2ND is only for Office Task
-	}
-}
-
-static void prvDebounceSW3Callback(TimerHandle_t xTimer){
-	if (SW3_Get() == KEY_PRESS_STATE){
-		xEventGroupSetBits(
-			xLab16EveGr,
-			BIT_SW3_STATE | BIT_3RD);//BIT_3RD is only for Office Task
-	}
-}
-
-static void prvDebounceSW4Callback(TimerHandle_t xTimer){
-	if (SW4_Get() == KEY_PRESS_STATE){
-		xEventGroupSetBits(
-			xLab16EveGr,
-			BIT_SW4_STATE);
-	}
-}
 
 //declare blinking timers' callbacks
 static void prvLED1BlinkingTimerCallback(TimerHandle_t xTimer){
@@ -186,58 +172,40 @@ static void prvLEDRGBBlinkingTimerCallback(TimerHandle_t xTimer){
 	LED_B_Toggle();
 }
 
-//callback functions of ISRs on key press
-static void prvSW1ISRCallback(GPIO_PIN pin, uintptr_t context){
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	xTimerResetFromISR(xDebounceSW1Timer, &xHigherPriorityTaskWoken);
-	portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
-}
-
-static void prvSW2ISRCallback(GPIO_PIN pin, uintptr_t context){
-	BaseType_t  xHigherPriorityTaskWoken = pdFALSE;
-	xTimerResetFromISR(xDebounceSW2Timer, &xHigherPriorityTaskWoken);
-	portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
-}
-
-static void prvSW3ISRCallback(GPIO_PIN pin, uintptr_t context){
+//callback function of the ISRs on key press, shared by all switches
+//the debounce service samples every switch until they all settled
+static void prvSWISRCallback(GPIO_PIN pin, uintptr_t context){
 	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	xTimerResetFromISR(xDebounceSW3Timer, &xHigherPriorityTaskWoken);
+	SYS_DEBOUNCE_WakeFromISR(&xHigherPriorityTaskWoken);
 	portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
 }
 
-static void prvSW4ISRCallback(GPIO_PIN pin, uintptr_t context){
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	xTimerResetFromISR(xDebounceSW4Timer, &xHigherPriorityTaskWoken);
-	portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
-}
-
-//callback function for UART6 ISR
-static void U6D0Callback(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
-	if (event == DMAC_TRANSFER_EVENT_COMPLETE){
-		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-		xEventGroupSetBitsFromISR(
-				xLab16EveGr, 
-				BIT_U6_TX_COMPLETE,
-				&xHigherPriorityTaskWoken);
-		portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+//register a switch with the debounce service, the bits are set in the event group when it is pressed
+static void prvSwitchAdd(GPIO_PIN pin, EventBits_t bits){
+	SYS_DEBOUNCE_INPUT input = {
+		.pin = pin,
+		.pressedLevel = KEY_PRESS_STATE,
+		.pressBits = bits,
+		.releaseBits = 0,
+		.eventGroup = xLab16EveGr,
+		.task = NULL
+	};
+	
+	if (SYS_DEBOUNCE_InputAdd(&input) == SYS_DEBOUNCE_INPUT_NONE){
+		SYS_CONSOLE_Print("cannot add switch to debounce service\r\n");
+		exit(EXIT_FAILURE);
 	}
+	
+	GPIO_PinInterruptCallbackRegister(
+				pin,
+				prvSWISRCallback,
+				0);
+	GPIO_PinInterruptEnable(pin);
 }
 
-//declare the buffer of UART6
-static uint8_t __attribute__ ((aligned (16))) u6TxBuffer[128] = {0};
-
 //declare a variable that verify the beginning of  Lab 16
 static uint8_t startLab16 = 0;
 
-//function for showing debug message
-static void Debug_msg(char * msg){
-	while (*msg){
-		while (U6STAbits.UTXBF);
-		U6TXREG = *msg++;
-		while (!U6STAbits.TRMT);
-	}
-}
-
 //lab16 application initialization
 static void Lab16_Initialize(void){
 	
@@ -251,92 +219,43 @@ static void Lab16_Initialize(void){
 	if (xTaskCreateStatic(
 			prvOfficeTaskFunc,
 			"Office Admin",
-			configMINIMAL_STACK_SIZE,
+			OFFICE_TASK_STACK_SIZE,
 			NULL,			
 			tskIDLE_PRIORITY+1,
 			xOfficeTaskStack,
 			&xOfficeTaskBuffer) == NULL) {
-		Debug_msg("cannot create task Office Admin \r\n");
-		exit(EXIT_FAILURE);
-	}
-	
-	//register callback for dmac's irq
-	DMAC_ChannelCallbackRegister(
-				DMAC_CHANNEL_0,
-				U6D0Callback,
-				0);
-	
-	//register callback for gpio's irq
-	GPIO_PinInterruptCallbackRegister(
-				SW1_PIN,
-				prvSW1ISRCallback,
-				0);
-	GPIO_PinInterruptEnable(SW1_PIN);
-	
-	GPIO_PinInterruptCallbackRegister(
-				SW2_PIN,
-				prvSW2ISRCallback,
-				0);
-	GPIO_PinInterruptEnable(SW2_PIN);
-	
-	GPIO_PinInterruptCallbackRegister(
-				SW3_PIN,
-				prvSW3ISRCallback,
-				0);
-	GPIO_PinInterruptEnable(SW3_PIN);
-	
-	GPIO_PinInterruptCallbackRegister(
-				SW4_PIN,
-				prvSW4ISRCallback,
-				0);
-	GPIO_PinInterruptEnable(SW4_PIN);
-	
-	//create debounce timers
-	xDebounceSW1Timer = xTimerCreateStatic(
-		"debounce SW1",
-		DEBOUNCE_PERIOD,
-		pdFALSE,
-		(void *)1,
-		prvDebounceSW1Callback,
-		&xDebounceSW1Buffer);
-	if (xDebounceSW1Timer == NULL){
-		Debug_msg("cannot create debounce timer for SW1 \r\n");
+		SYS_CONSOLE_Print("cannot create task Office Admin \r\n");
 		exit(EXIT_FAILURE);
 	}
 	
-	xDebounceSW2Timer = xTimerCreateStatic(
-		"debounce SW2",
-		DEBOUNCE_PERIOD,
-		pdFALSE,
-		(void *)2,
-		prvDebounceSW2Callback,
-		&xDebounceSW2Buffer);
-	if (xDebounceSW2Timer == NULL){
-		Debug_msg ("cannot create debounce timer for SW2 \r\n");
-		exit(EXIT_FAILURE);
+	//take a DMAC channel started by UART6 TX for the log service, messages are queued and sent in background
+	SYS_DMA_Initialize();
+	//without a free channel the log writes every message by polling, like the console before the scheduler
+	if (SYS_LOG_Initialize(SYS_DMA_ChannelAllocate(DMAC_CHANNEL_PRIORITY_3, INT_SOURCE_UART6_TX)) == false){
+		SYS_CONSOLE_Print("no DMAC channel for the log, messages are polled\r\n");
 	}
-	
-	xDebounceSW3Timer = xTimerCreateStatic(
-		"debounce SW3",
-		DEBOUNCE_PERIOD,
-		pdFALSE,
-		(void *)3,
-		prvDebounceSW3Callback,
-		&xDebounceSW3Buffer);
-	if (xDebounceSW3Timer == NULL){
-		Debug_msg("cannot create debounce timer for SW3\r\n");
-		exit(EXIT_FAILURE);
+	//take a software started channel for large memory copies
+	SYS_DMA_MemoryInitialize();
+	//build the crc tables and take a channel for the dmac crc engine
+	SYS_CRC_Initialize();
+	//take a channel started by UART6 RX, it stops on each end of line
+	if (SYS_UART_RX_Initialize('\n') == true){
+		if (xTaskCreateStatic(
+				prvComRxFunc,
+				"Console Input",
+				COM_RX_TASK_STACK_SIZE,
+				NULL,
+				tskIDLE_PRIORITY+1,
+				xComRxTaskStack,
+				&xComRxTaskBuffer) == NULL) {
+			SYS_CONSOLE_Print("cannot create task Console Input \r\n");
+			exit(EXIT_FAILURE);
+		}
 	}
 	
-	xDebounceSW4Timer = xTimerCreateStatic(
-		"debounce SW4",
-		DEBOUNCE_PERIOD,
-		pdFALSE,
-		(void *)4,
-		prvDebounceSW4Callback,
-		&xDebounceSW4Buffer);
-	if (xDebounceSW4Timer == NULL){
-		Debug_msg("cannot create debounce timer for SW4\r\n");
+	//one timer samples all switches, it only runs while a switch is bouncing
+	if (SYS_DEBOUNCE_Initialize(false) == false){
+		SYS_CONSOLE_Print("cannot create debounce timer\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -349,7 +268,7 @@ static void Lab16_Initialize(void){
 		prvLED1BlinkingTimerCallback,
 		&xLED1BlinkingTimerBuffer);
 	if (xLED1BlinkingTimer == NULL){
-		Debug_msg("cannot create timer for blinking LED1\r\n");
+		SYS_CONSOLE_Print("cannot create timer for blinking LED1\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -361,7 +280,7 @@ static void Lab16_Initialize(void){
 		prvLED2BlinkingTimerCallback,
 		&xLED2BlinkingTimerBuffer);
 	if (xLED2BlinkingTimer == NULL){
-		Debug_msg("cannot create timer for blinking LED2\r\n");
+		SYS_CONSOLE_Print("cannot create timer for blinking LED2\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -373,7 +292,7 @@ static void Lab16_Initialize(void){
 		prvLED3BlinkingTimerCallback,
 		&xLED3BlinkingTimerBuffer);
 	if (xLED3BlinkingTimer == NULL){
-		Debug_msg("cannot create timer for blinking LED3\r\n");
+		SYS_CONSOLE_Print("cannot create timer for blinking LED3\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -385,13 +304,20 @@ static void Lab16_Initialize(void){
 		prvLEDRGBBlinkingTimerCallback,
 		&xLEDRGBBlinkingTimerBuffer);
 	if (xLEDRGBBlinkingTimer == NULL){
-		Debug_msg("cannot create timer for blinking LED RGB\r\n");
+		SYS_CONSOLE_Print("cannot create timer for blinking LED RGB\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
 	//create mutex
 	xMutex = xSemaphoreCreateMutex();
 	
+	//create the mutex guarding the task loads shown by the console
+	xStatsMutex = xSemaphoreCreateMutexStatic(&xStatsMutexBuffer);
+	if (xStatsMutex == NULL){
+		SYS_CONSOLE_Print("cannot create mutex for the task loads\r\n");
+		exit(EXIT_FAILURE);
+	}
+	
 	//create tasks
 	if (xTaskCreateStatic(
 			prvLED1Func,
@@ -401,7 +327,7 @@ static void Lab16_Initialize(void){
 			tskIDLE_PRIORITY+1,
 			xLed1TaskStack,
 			&xLed1TaskBuffer) == NULL){
-		Debug_msg("cannot create task for LED1\r\n");
+		SYS_CONSOLE_Print("cannot create task for LED1\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -413,7 +339,7 @@ static void Lab16_Initialize(void){
 			tskIDLE_PRIORITY+1,
 			xLed2TaskStack,
 			&xLed2TaskBuffer) == NULL){
-		Debug_msg("cannot create task for LED2\r\n");
+		SYS_CONSOLE_Print("cannot create task for LED2\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -425,7 +351,7 @@ static void Lab16_Initialize(void){
 			tskIDLE_PRIORITY+1,
 			xLed3TaskStack,
 			&xLed3TaskBuffer) == NULL){
-		Debug_msg("cannot create task for LED3\r\n");
+		SYS_CONSOLE_Print("cannot create task for LED3\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
@@ -437,22 +363,29 @@ static void Lab16_Initialize(void){
 			tskIDLE_PRIORITY+1,
 			xLedRGBTaskStack,
 			&xLedRGBTaskBuffer) == NULL){
-		Debug_msg("cannot create task for LED RGB\r\n");
+		SYS_CONSOLE_Print("cannot create task for LED RGB\r\n");
 		exit(EXIT_FAILURE);
 	}
 		
 	//create event group
 	xLab16EveGr = xEventGroupCreateStatic(&xLab16EveGrBuffer);
 	if (xLab16EveGr == NULL){
-		Debug_msg("cannot create event group\r\n");
+		SYS_CONSOLE_Print("cannot create event group\r\n");
 		exit(EXIT_FAILURE);
 	}
 	
 	//clear all bits of the event group
 	//the handle is valid with xEventGroupCreateStatic() instead of xEventGroupCreate()
+	//the top byte holds the kernel control bits, configASSERT stops on clearing them
 	xEventGroupClearBits(
 			xLab16EveGr,
-			0xFFFFFFFF);
+			0x00FFFFFF);
+	
+	//register the switches once the event group exists
+	prvSwitchAdd(SW1_PIN, BIT_SW1_STATE | BIT_1ST);//BIT_1ST is only for Office Task
+	prvSwitchAdd(SW2_PIN, BIT_SW2_STATE | BIT_2ND);//BIT_2ND is only for Office Task
+	prvSwitchAdd(SW3_PIN, BIT_SW3_STATE | BIT_3RD);//BIT_3RD is only for Office Task
+	prvSwitchAdd(SW4_PIN, BIT_SW4_STATE);
 	
 }
 
@@ -483,24 +416,126 @@ int main ( void )
     return ( EXIT_FAILURE );
 }
 
+//declare run time snapshots, the previous one and the current one alternate
+//they are static because they are too large for the task stack
+static SYS_RTSTATS_SNAPSHOT xStatsSnapshot[2];
+static SYS_RTSTATS_SNAPSHOT xStatsDelta;
+//the last delta handed to the console task, guarded by xStatsMutex
+static SYS_RTSTATS_SNAPSHOT xStatsPublished;
+static uint8_t uStatsCurrent = 0;
+static uint32_t ulLoadSequence = 0;
+
+//send the cpu load since the previous call as a telemetry line, the load is the time the idle task did not get
+//the line is "$LOAD,<sequence>,<load>*<crc>", the crc is the CRC-16/CCITT-FALSE of everything before the '*'
+static void prvShowLoad(void){
+	TaskHandle_t xIdleTask = xTaskGetIdleTaskHandle();
+	uint32_t idle = 0;
+	char frame[32];
+	int length;
+	
+	SYS_RTSTATS_Snapshot(&xStatsSnapshot[uStatsCurrent]);
+	SYS_RTSTATS_Diff(&xStatsSnapshot[uStatsCurrent ^ 1], &xStatsSnapshot[uStatsCurrent], &xStatsDelta);
+	uStatsCurrent ^= 1;
+	
+	for (UBaseType_t i = 0; i < xStatsDelta.taskCount; i++){
+		if (xStatsDelta.task[i].handle == xIdleTask){
+			idle = SYS_RTSTATS_Permille(xStatsDelta.task[i].runTime, xStatsDelta.time);
+		}
+	}
+	
+	//hand the delta to the console task
+	if (xSemaphoreTake(xStatsMutex, portMAX_DELAY) == pdTRUE){
+		xStatsPublished = xStatsDelta;
+		xSemaphoreGive(xStatsMutex);
+	}
+	
+	length = snprintf(frame, sizeof(frame), "$LOAD,%lu,%u.%u", (unsigned long)ulLoadSequence++,
+				(unsigned)((1000 - idle) / 10), (unsigned)((1000 - idle) % 10));
+	(void)SYS_LOG_Printf("%s*%04X\r\n", frame,
+				(unsigned)SYS_CRC_Calculate(SYS_CRC_TYPE_CRC16_CCITT, frame, (size_t)length));
+}
+
+//wait until the log ring is empty, used by output longer than the ring
+static void prvLogFlush(void){
+	while (SYS_LOG_IsIdle() == false){
+		vTaskDelay(1);
+	}
+}
+
+//source and target of the dma memory calibration, on cache lines like any dma buffer
+static uint8_t SYS_DMA_BUFFER(xCopySource, COPY_SWEEP_MAX);
+static uint8_t SYS_DMA_BUFFER(xCopyTarget, COPY_SWEEP_MAX);
+
+//the fastest copy of size bytes in CPU cycles, by memcpy or by the dma memory service
+static uint32_t prvCopyBench(bool dma, size_t size){
+	uint32_t best = UINT32_MAX;
+	for (uint32_t round = 0; round < COPY_SWEEP_ROUNDS; round++){
+		uint32_t start = _CP0_GET_COUNT();
+		if (dma){
+			(void)SYS_DMA_MemoryCopy(xCopyTarget, xCopySource, size);
+		} else {
+			(void)memcpy(xCopyTarget, xCopySource, size);
+		}
+		uint32_t count = _CP0_GET_COUNT() - start;
+		if (count < best){
+			best = count;
+		}
+	}
+	return CORE_TIMER_CYCLES(best);
+}
+
+//time memcpy against the dmac from 16 B to 4 KB and set the dma copy threshold from it
+//the threshold is the smallest size from which the dmac wins at every larger size
+static void prvDmaCopyCalibrate(void){
+	uint32_t cpu[COPY_SWEEP_STEPS];
+	uint32_t dma[COPY_SWEEP_STEPS];
+	size_t threshold = SIZE_MAX;
+	bool copied = true;
+	
+	for (size_t i = 0; i < COPY_SWEEP_MAX; i++){
+		xCopySource[i] = (uint8_t)(i * 7);
+	}
+	
+	//every copy goes to the dmac during the sweep
+	SYS_DMA_MemoryThresholdSet(0);
+	for (uint32_t k = 0; k < COPY_SWEEP_STEPS; k++){
+		size_t size = (size_t)COPY_SWEEP_MIN << k;
+		cpu[k] = prvCopyBench(false, size);
+		(void)memset(xCopyTarget, 0, size);
+		dma[k] = prvCopyBench(true, size);
+		if (memcmp(xCopyTarget, xCopySource, size) != 0){
+			copied = false;
+		}
+	}
+	
+	for (uint32_t k = COPY_SWEEP_STEPS; (k > 0) && (dma[k - 1] < cpu[k - 1]); k--){
+		threshold = (size_t)COPY_SWEEP_MIN << (k - 1);
+	}
+	if (copied == false){
+		threshold = SIZE_MAX;
+	}
+	SYS_DMA_MemoryThresholdSet(threshold);
+	
+	//print after the sweep so the log dma does not share the bus with it
+	for (uint32_t k = 0; k < COPY_SWEEP_STEPS; k++){
+		prvLogFlush();
+		(void)SYS_LOG_Printf("copy %4u B memcpy %6lu dma %6lu cycles\r\n", (unsigned)(COPY_SWEEP_MIN << k),
+					(unsigned long)cpu[k], (unsigned long)dma[k]);
+	}
+	prvLogFlush();
+	if (copied == false){
+		(void)SYS_LOG_Print("dma copy FAILED, copies stay on the cpu\r\n");
+	} else if (threshold == SIZE_MAX){
+		(void)SYS_LOG_Print("dma copy never faster, copies stay on the cpu\r\n");
+	} else {
+		(void)SYS_LOG_Printf("dma copy threshold %u B\r\n", (unsigned)threshold);
+	}
+}
+
 //create the function that show a message via DMA0 and UART6
+//the message is queued in the log ring and the task continues without waiting for the transfer
 static void prvShowMsg(char * msg){
-		
-	sprintf((char *)u6TxBuffer, msg);
-	DCACHE_CLEAN_BY_ADDR(
-				(uint32_t)u6TxBuffer,
-				strlen((const char *)u6TxBuffer));
-	DMAC_ChannelTransfer(
-			DMAC_CHANNEL_0,
-			(const void *)u6TxBuffer,
-			strlen((const char *)u6TxBuffer),
-			(const void *)&U6TXREG, 1, 1);
-	xEventGroupWaitBits(
-			xLab16EveGr,
-			BIT_U6_TX_COMPLETE,
-			pdTRUE,
-			pdFALSE,
-			portMAX_DELAY);			
+	SYS_LOG_Print(msg);
 }
 
 static void prvOfficeTaskFunc(void * pvParams){
@@ -508,22 +543,16 @@ static void prvOfficeTaskFunc(void * pvParams){
 	for(;;){
 		EventBits_t bits = xEventGroupGetBits(xLab16EveGr);
 		if (((bits & 0x0700) == 0) && (startLab16 == 0)) {//verify the first time of Office Task
-			if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-				prvShowMsg("Lab16-Event Group Synchronization \r\n");
-				startLab16++;
-				xSemaphoreGive(xMutex);
-			}			
+			prvShowMsg("Lab16-Event Group Synchronization \r\n");
+			//check the crc service once, its dmac path needs the scheduler running
+			prvShowMsg(SYS_CRC_SelfTest() ? "crc self test passed\r\n" : "crc self test FAILED\r\n");
+			prvDmaCopyCalibrate();
+			startLab16++;
 		} else if (((bits & 0x0700) == 0) && (startLab16 ==1)){//verify no action after 10 seconds
-			if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-				prvShowMsg("please press the switches ... \r\n");
-				xSemaphoreGive(xMutex);
-			}
+			prvShowMsg("please press the switches ... \r\n");
 		}
 		else {
-			if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-				prvShowMsg("Awesome!!!\r\n");
-				xSemaphoreGive(xMutex);
-			}
+			prvShowMsg("Awesome!!!\r\n");
 			//clear bits after checking with period of 10seconds
 			if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE)
 			{
@@ -534,6 +563,7 @@ static void prvOfficeTaskFunc(void * pvParams){
 			}
 			
 		}
+		prvShowLoad();
 		vTaskDelay(pdMS_TO_TICKS(5000));
 	}
 }
@@ -625,13 +655,43 @@ static void prvLED3Func(void * pvParams){
 	}
 }
 
+//show the load of every task over the last period of the Office task
+static void prvShowTop(void){
+	static SYS_RTSTATS_SNAPSHOT xTop;
+	if (xSemaphoreTake(xStatsMutex, portMAX_DELAY) == pdTRUE){
+		xTop = xStatsPublished;
+		xSemaphoreGive(xStatsMutex);
+	}
+	for (UBaseType_t i = 0; i < xTop.taskCount; i++){
+		uint32_t load = SYS_RTSTATS_Permille(xTop.task[i].runTime, xTop.time);
+		prvLogFlush();
+		(void)SYS_LOG_Printf("%-16s %3u.%u %%\r\n", pcTaskGetName(xTop.task[i].handle),
+					(unsigned)(load / 10), (unsigned)(load % 10));
+	}
+}
+
+//echo every line received on UART6 back through the log, "top" shows the load of every task
+static void prvComRxFunc(void * pvParams){
+	static uint8_t line[SYS_UART_RX_BUFFER_SIZE];
+	for (;;){
+		//wake up every second even without input so a receiver overrun gets cleared
+		size_t length = SYS_UART_RX_LineRead(line, sizeof(line), pdMS_TO_TICKS(1000));
+		size_t text = length;
+		while ((text > 0) && ((line[text - 1] == '\r') || (line[text - 1] == '\n'))){
+			text--;
+		}
+		if ((text == 3) && (memcmp(line, "top", 3) == 0)){
+			prvShowTop();
+		} else if (length > 0){
+			(void)SYS_LOG_Write(line, length);
+		}
+	}
+}
+
 //this task is for service
 static void prvLEDRGBFunc(void * pvParams){
 	for (;;){
-		if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-			prvShowMsg("LEDRGB and SW4 \r\n");
-			xSemaphoreGive(xMutex);
-		}
+		prvShowMsg("LEDRGB and SW4 \r\n");
 		vTaskDelay(pdMS_TO_TICKS(5000));
 	}
 
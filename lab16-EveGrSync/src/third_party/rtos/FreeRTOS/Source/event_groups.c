@@ -79,6 +79,21 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * With configUSE_EVENT_GROUP_DIRECT_ISR set to 1 interrupts access the event
+ * bits and the list of waiting tasks directly, so where the task level
+ * functions test or update them with the scheduler suspended they also do so
+ * within a critical section.  Otherwise a bit set by an interrupt between the
+ * test and the task blocking would be missed.
+ */
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+        #define eventENTER_ISR_EXCLUSION()    taskENTER_CRITICAL()
+        #define eventEXIT_ISR_EXCLUSION()     taskEXIT_CRITICAL()
+    #else
+        #define eventENTER_ISR_EXCLUSION()
+        #define eventEXIT_ISR_EXCLUSION()
+    #endif
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -204,6 +219,8 @@
 
         vTaskSuspendAll();
         {
+            eventENTER_ISR_EXCLUSION();
+
             uxOriginalBitValue = pxEventBits->uxEventBits;
 
             ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
@@ -244,6 +261,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            eventEXIT_ISR_EXCLUSION();
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -335,6 +354,8 @@
 
         vTaskSuspendAll();
         {
+            eventENTER_ISR_EXCLUSION();
+
             const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
             /* Check to see if the wait condition is already met or not. */
@@ -400,6 +421,8 @@
 
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
+
+            eventEXIT_ISR_EXCLUSION();
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -501,7 +524,33 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+        BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
+                                                const EventBits_t uxBitsToClear )
+        {
+            EventGroup_t * pxEventBits = xEventGroup;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* Clearing bits never unblocks a task, so there is nothing to defer. */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xEventGroupClearBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                                 const EventBits_t uxBitsToClear )
@@ -518,7 +567,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -566,6 +615,8 @@
         pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
         {
+            eventENTER_ISR_EXCLUSION();
+
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
             pxListItem = listGET_HEAD_ENTRY( pxList );
@@ -638,6 +689,8 @@
 
             /* Snapshot resulting bits. */
             uxReturnBits = pxEventBits->uxEventBits;
+
+            eventEXIT_ISR_EXCLUSION();
         }
         ( void ) xTaskResumeAll();
 
@@ -660,6 +713,8 @@
 
         vTaskSuspendAll();
         {
+            eventENTER_ISR_EXCLUSION();
+
             traceEVENT_GROUP_DELETE( xEventGroup );
 
             while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
@@ -669,6 +724,8 @@
                 configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
                 vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
             }
+
+            eventEXIT_ISR_EXCLUSION();
         }
         ( void ) xTaskResumeAll();
 
@@ -812,7 +869,78 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+        BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            ListItem_t * pxListItem;
+            ListItem_t * pxNext;
+            ListItem_t const * pxListEnd;
+            List_t const * pxList;
+            EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+            EventGroup_t * pxEventBits = xEventGroup;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+            pxList = &( pxEventBits->xTasksWaitingForBits );
+            pxListEnd = listGET_END_MARKER( pxList );
+
+            /* The same walk as xEventGroupSetBits(), but in a critical section
+             * in place of the scheduler lock, so the unblocked tasks are ready
+             * when the interrupt returns rather than once the timer task ran. */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+                pxListItem = listGET_HEAD_ENTRY( pxList );
+
+                pxEventBits->uxEventBits |= uxBitsToSet;
+
+                while( pxListItem != pxListEnd )
+                {
+                    pxNext = listGET_NEXT( pxListItem );
+                    uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+                    /* Split the bits waited for from the control bits. */
+                    uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+                    uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+                    if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor,
+                                              ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE ) != pdFALSE )
+                    {
+                        if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                        {
+                            uxBitsToClear |= uxBitsWaitedFor;
+                        }
+
+                        if( ( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE ) &&
+                            ( pxHigherPriorityTaskWoken != NULL ) )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                    }
+
+                    pxListItem = pxNext;
+                }
+
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xEventGroupSetBitsFromISR( pdPASS );
+
+            return pdPASS;
+        }
+
+    #elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                               const EventBits_t uxBitsToSet,
@@ -830,7 +958,7 @@
             return xReturn;
         }
 
-    #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+    #endif /* if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -65,7 +65,11 @@
 
 /* The EXL bit is set to ensure interrupts do not occur while the context of
 the first task is being restored. */
-#if ( __mips_hard_float == 1 )
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+    /* Tasks start with the FPU disabled so their first FP instruction traps
+    into the lazy FPU switch. */
+    #define portINITIAL_SR          ( portIE_BIT | portEXL_BIT | portMX_BIT | portFR_BIT )
+#elif ( __mips_hard_float == 1 )
     #define portINITIAL_SR          ( portIE_BIT | portEXL_BIT | portMX_BIT | portFR_BIT | portCU1_BIT )
 #else
     #define portINITIAL_SR          ( portIE_BIT | portEXL_BIT | portMX_BIT )
@@ -100,6 +104,52 @@ override this behaviour by:
     #ifndef configCLEAR_TICK_TIMER_INTERRUPT
         #error If configTICK_INTERRUPT_VECTOR is defined in application code then configCLEAR_TICK_TIMER_INTERRUPT must also be defined in application code.
     #endif
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        #error The tickless idle implementation in port.c reprograms Timer 1, provide portSUPPRESS_TICKS_AND_SLEEP() for any other tick timer.
+    #endif
+#endif
+
+/* The tick runs at the kernel priority unless configTICK_INTERRUPT_PRIORITY
+raises it, typically to put it on a shadow register set.  These defaults match
+the ones in ISR_Support.h. */
+#ifndef configTICK_INTERRUPT_PRIORITY
+    #define configTICK_INTERRUPT_PRIORITY configKERNEL_INTERRUPT_PRIORITY
+#endif
+
+#if( ( configTICK_INTERRUPT_PRIORITY < configKERNEL_INTERRUPT_PRIORITY ) || ( configTICK_INTERRUPT_PRIORITY > configMAX_SYSCALL_INTERRUPT_PRIORITY ) )
+    #error configTICK_INTERRUPT_PRIORITY must be between configKERNEL_INTERRUPT_PRIORITY and configMAX_SYSCALL_INTERRUPT_PRIORITY
+#endif
+
+#ifndef configUSE_SHADOW_REGISTER_ISR
+    #define configUSE_SHADOW_REGISTER_ISR 0
+#endif
+
+#if ( configUSE_SHADOW_REGISTER_ISR == 1 )
+    #ifndef configSHADOW_REGISTER_ISR_PRIORITY
+        #define configSHADOW_REGISTER_ISR_PRIORITY ( configKERNEL_INTERRUPT_PRIORITY + 1 )
+    #endif
+
+    /* The yield interrupt saves the registers of the task it interrupts, so
+    the kernel priority must stay on the normal register set. */
+    #if( ( configSHADOW_REGISTER_ISR_PRIORITY <= configKERNEL_INTERRUPT_PRIORITY ) || ( configSHADOW_REGISTER_ISR_PRIORITY > 7 ) )
+        #error configSHADOW_REGISTER_ISR_PRIORITY must be above configKERNEL_INTERRUPT_PRIORITY and at most 7
+    #endif
+
+    /* PRISS has a 4 bit field per priority, priority n is mapped to shadow
+    set n.  The system init writes it before interrupts are enabled, see
+    ISR_Support.h. */
+    #define portPRISS_FIELD_BITS    4
+    #define portSHADOW_SET_COUNT    7
+#endif
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    /* While the tick is suppressed Timer 1 counts at 1:256 instead of 1:8, so
+    one sleep count is 32 tick counts and the 16 bit period covers
+    ( 0xffff * 32 ) / 12500 = 167 ticks with a 100 MHz PBCLK3 and 1 kHz tick. */
+    #define portSLEEP_PRESCALE_BITS     3
+    #define portSLEEP_COUNT_SCALE       ( 256UL / portTIMER_PRESCALE )
+    #define portTICK_TIMER_COUNTS       ( ( configPERIPHERAL_CLOCK_HZ / portTIMER_PRESCALE ) / configTICK_RATE_HZ )
+    #define portMAX_SUPPRESSED_TICKS    ( ( 0xffffUL * portSLEEP_COUNT_SCALE ) / portTICK_TIMER_COUNTS )
 #endif
 
 /* Let the user override the pre-loading of the initial RA with the address of
@@ -166,6 +216,21 @@ const StackType_t * const xISRStackTop = &( xISRStack[ ( configISR_STACK_SIZE &
     uint32_t ulTaskHasFPUContext = 0;
 #endif
 
+/* Lazy FPU switching.  Each task has an FPU save area at the top of its stack,
+pvPortFPUContext points to the one of the running task and is saved as part of
+the task context in place of ulTaskHasFPUContext.  The FPU registers hold the
+state of pvPortFPUOwnerTCB, to be saved to pvPortFPUOwnerContext when another
+task wants the FPU. */
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+    /* FCSR, a pad word and the 32 double registers. */
+    #define portFPU_CONTEXT_WORDS   ( 264 / sizeof( StackType_t ) )
+    #define portFPU_FCSR_WORD       0
+
+    void *pvPortFPUContext = NULL;
+    void *pvPortFPUOwnerContext = NULL;
+    void *pvPortFPUOwnerTCB = NULL;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -173,6 +238,17 @@ const StackType_t * const xISRStackTop = &( xISRStack[ ( configISR_STACK_SIZE &
  */
 StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
 {
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+StackType_t *pxFPUContext;
+
+    /* Reserve the FPU save area of the task below the top of stack.  The size
+    is a multiple of 8 so the area and the rest of the stack stay aligned. */
+    pxTopOfStack -= portFPU_CONTEXT_WORDS;
+    pxFPUContext = pxTopOfStack;
+    memset( ( void * ) pxFPUContext, 0, portFPU_CONTEXT_WORDS * sizeof( StackType_t ) );
+    pxFPUContext[ portFPU_FCSR_WORD ] = ( StackType_t ) portINITIAL_FPSCR;
+#endif
+
     /* Ensure 8 byte alignment is maintained when leaving this function. */
     pxTopOfStack--;
     pxTopOfStack--;
@@ -201,7 +277,11 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
     *pxTopOfStack = (StackType_t) pvParameters; /* Parameters to pass in. */
     pxTopOfStack -= 15;
 
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+    *pxTopOfStack = (StackType_t) pxFPUContext; /* FPU save area, see pvPortFPUContext */
+#else
     *pxTopOfStack = (StackType_t) pdFALSE; /*by default disable FPU context save on parts with FPU */
+#endif
 
     return pxTopOfStack;
 }
@@ -237,7 +317,7 @@ const uint32_t ulCompareMatch = ( (configPERIPHERAL_CLOCK_HZ / portTIMER_PRESCAL
     T1CON = 0x0000;
     T1CONbits.TCKPS = portPRESCALE_BITS;
     PR1 = ulCompareMatch;
-    IPC1bits.T1IP = configKERNEL_INTERRUPT_PRIORITY;
+    IPC1bits.T1IP = configTICK_INTERRUPT_PRIORITY;
 
     /* Clear the interrupt as a starting condition. */
     IFS0bits.T1IF = 0;
@@ -281,6 +361,26 @@ extern void *pxCurrentTCB;
     IEC0CLR = _IEC0_CS0IE_MASK;
     IEC0SET = 1 << _IEC0_CS0IE_POSITION;
 
+    #if ( configUSE_SHADOW_REGISTER_ISR == 1 )
+    {
+    uint32_t ulPriority, ulPriss = 0;
+
+        /* Each priority from configSHADOW_REGISTER_ISR_PRIORITY up must have
+        its own shadow set, so interrupts that nest run on different sets.
+        Writing PRISS here would be too late, an interrupt taken between
+        SYS_Initialize and this point would already have run its SRS wrapper
+        on set 0.  The global pointer of every set was loaded by the startup
+        code. */
+        for( ulPriority = configSHADOW_REGISTER_ISR_PRIORITY; ulPriority <= portSHADOW_SET_COUNT; ulPriority++ )
+        {
+            ulPriss |= ulPriority << ( ulPriority * portPRISS_FIELD_BITS );
+        }
+
+        configASSERT( PRISS == ulPriss );
+        ( void ) ulPriss;
+    }
+    #endif /* configUSE_SHADOW_REGISTER_ISR */
+
     /* Setup the timer to generate the tick.  Interrupts will have been
     disabled by the time we get here. */
     vApplicationSetupTickTimerInterrupt();
@@ -288,6 +388,14 @@ extern void *pxCurrentTCB;
     /* Kick off the highest priority task that has been created so far.
     Its stack location is loaded into uxSavedTaskStackPointer. */
     uxSavedTaskStackPointer = *( UBaseType_t * ) pxCurrentTCB;
+
+    #if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+    {
+        /* The yield interrupt loads this on every later switch. */
+        pvPortFPUContext = ( void * ) *( UBaseType_t * ) uxSavedTaskStackPointer;
+    }
+    #endif
+
     vPortStartFirstTask();
 
     /* Should never get here as the tasks will now be executing!  Call the task
@@ -322,6 +430,92 @@ UBaseType_t uxSavedStatus;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+    uint32_t ulCountsIntoTick, ulSleepCounts, ulElapsedCounts;
+    TickType_t xModifiableIdleTime;
+
+        if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+        }
+
+        /* Clear IE and leave the IPL at 0, where the idle task runs.  An
+        interrupt at or below the CPU priority does not end WAIT, so raising
+        the IPL here would leave the core asleep until the tick.  With only
+        IE clear, any enabled interrupt ends WAIT and is vectored once IE is
+        set again below, after the tick count has been corrected.  This is
+        how change notice and DMA interrupts wake the idle task. */
+        configASSERT( ( _CP0_GET_STATUS() & portALL_IPL_BITS ) == 0U );
+        __builtin_disable_interrupts();
+
+        /* Stop the tick.  A task made ready or a tick pending since the idle
+        task decided to sleep is left to the normal path. */
+        T1CONCLR = _T1CON_ON_MASK;
+
+        if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( ( IFS0 & _IFS0_T1IF_MASK ) != 0U ) )
+        {
+            T1CONSET = _T1CON_ON_MASK;
+            __builtin_enable_interrupts();
+            return;
+        }
+
+        /* Sleep for what is left of the current tick plus the remaining
+        ticks, rounded down to whole sleep counts. */
+        ulCountsIntoTick = TMR1;
+        ulSleepCounts = ( ( ( uint32_t ) xExpectedIdleTime * portTICK_TIMER_COUNTS ) - ulCountsIntoTick ) / portSLEEP_COUNT_SCALE;
+
+        T1CONbits.TCKPS = portSLEEP_PRESCALE_BITS;
+        TMR1 = 0;
+        PR1 = ulSleepCounts - 1UL;
+        T1CONSET = _T1CON_ON_MASK;
+
+        xModifiableIdleTime = xExpectedIdleTime;
+        configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+        if( xModifiableIdleTime > 0 )
+        {
+            /* OSCCON.SLPEN is left clear, so WAIT enters Idle mode and the
+            peripheral clocks, Timer 1 included, keep running. */
+            __asm volatile ( "wait" );
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        T1CONCLR = _T1CON_ON_MASK;
+
+        if( ( IFS0 & _IFS0_T1IF_MASK ) != 0U )
+        {
+            /* The whole period elapsed and TMR1 went back to 0. */
+            ulElapsedCounts = ulSleepCounts;
+            configCLEAR_TICK_TIMER_INTERRUPT();
+        }
+        else
+        {
+            /* Another interrupt ended the sleep early. */
+            ulElapsedCounts = TMR1;
+        }
+
+        ulElapsedCounts = ( ulElapsedCounts * portSLEEP_COUNT_SCALE ) + ulCountsIntoTick;
+
+        /* Restart the tick with the fraction of a tick already gone, so the
+        next tick interrupt stays in phase.  At most 31 counts of the
+        prescaler are lost on each switch. */
+        T1CONbits.TCKPS = portPRESCALE_BITS;
+        TMR1 = ulElapsedCounts % portTICK_TIMER_COUNTS;
+        PR1 = portTICK_TIMER_COUNTS - 1UL;
+        T1CONSET = _T1CON_ON_MASK;
+
+        vTaskStepTick( ( TickType_t ) ( ulElapsedCounts / portTICK_TIMER_COUNTS ) );
+
+        __builtin_enable_interrupts();
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxPortSetInterruptMaskFromISR( void )
 {
 UBaseType_t uxSavedStatusRegister;
@@ -367,3 +561,25 @@ void vPortClearInterruptMaskFromISR( UBaseType_t uxSavedStatusRegister )
 #endif /* __mips_hard_float == 1 */
 
 /*-----------------------------------------------------------*/
+
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+
+    void vPortCleanUpTCB( void *pxTCB )
+    {
+        /* The stack holding the save area of the owner is about to be freed.
+        The registers are not saved anywhere when the next task claims the
+        FPU.  Preemption is held off so no other task claims it in between. */
+        portENTER_CRITICAL();
+        {
+            if( pvPortFPUOwnerTCB == pxTCB )
+            {
+                pvPortFPUOwnerTCB = NULL;
+                pvPortFPUOwnerContext = NULL;
+            }
+        }
+        portEXIT_CRITICAL();
+    }
+
+#endif /* ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 ) */
+
+/*-----------------------------------------------------------*/
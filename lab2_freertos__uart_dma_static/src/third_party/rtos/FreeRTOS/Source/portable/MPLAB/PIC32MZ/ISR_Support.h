@@ -35,6 +35,40 @@
 #define portTASK_HAS_FPU_STACK_LOCATION     0
 #define portFPU_CONTEXT_SIZE            264
 
+/* Coprocessor Unusable exception code and CU1 in STATUS, used by the lazy FPU
+switch of configUSE_TASK_FPU_SUPPORT 2. */
+#define portEXCCODE_CPU                 11
+#define portSTATUS_CU1_SHIFT            29
+
+/* Frame of an interrupt that runs on a shadow register set, see
+portSAVE_CONTEXT_SRS.  The bottom 16 bytes are the argument area of the
+handler. */
+#define portSRS_CONTEXT_SIZE            64
+#define portSRS_DSPCONTROL_STACK_LOCATION   48
+#define portSRS_SRSCTL_STACK_LOCATION   52
+#define portSRS_EPC_STACK_LOCATION      56
+#define portSRS_STATUS_STACK_LOCATION   60
+
+/* Set configUSE_SHADOW_REGISTER_ISR to 1 to have every interrupt priority from
+configSHADOW_REGISTER_ISR_PRIORITY up to 7 mapped to its own shadow register
+set.  The wrappers of all interrupts at those priorities must then use
+portSAVE_CONTEXT_SRS and portRESTORE_CONTEXT_SRS, the ones below them keep
+portSAVE_CONTEXT and portRESTORE_CONTEXT.  The tick uses the shadow set when
+configTICK_INTERRUPT_PRIORITY is raised to a mapped priority.
+PRISS must hold that mapping before interrupts are first enabled, so it is
+written by EVIC_Initialize, not by the port.  xPortStartScheduler asserts it. */
+#ifndef configUSE_SHADOW_REGISTER_ISR
+    #define configUSE_SHADOW_REGISTER_ISR           0
+#endif
+
+#ifndef configSHADOW_REGISTER_ISR_PRIORITY
+    #define configSHADOW_REGISTER_ISR_PRIORITY      ( configKERNEL_INTERRUPT_PRIORITY + 1 )
+#endif
+
+#ifndef configTICK_INTERRUPT_PRIORITY
+    #define configTICK_INTERRUPT_PRIORITY           configKERNEL_INTERRUPT_PRIORITY
+#endif
+
 /******************************************************************/
 .macro  portSAVE_FPU_REGS    offset, base
     /* Macro to assist with saving just the FPU registers to the
@@ -430,3 +464,129 @@
     nop
 
     .endm
+
+/******************************************************************/
+.macro  portSAVE_CONTEXT_SRS
+
+    /* The interrupt runs on the shadow register set PRISS maps its priority
+    to, so the GPRs of the interrupted code stay untouched in their own set
+    and only what a register set does not hold is saved: EPC, STATUS,
+    SRSCtl, the DSP accumulators and DSPControl.  The handler must not use
+    the FPU.  sp of the shadow set is stale, start from the one of the
+    interrupted code. */
+    rdpgpr      sp, sp
+
+    /* If the nesting count is 0 then swap to the system stack, as
+    portSAVE_CONTEXT does.  The increment in the delay slot runs on both
+    paths. */
+    la          k0, uxInterruptNesting
+    lw          k1, (k0)
+    bne         k1, zero, 1f
+    addiu       k1, k1, 1
+
+    la          sp, xISRStackTop
+    lw          sp, (sp)
+
+1:  sw          k1, 0(k0)
+    addiu       sp, sp, -portSRS_CONTEXT_SIZE
+
+    /* A nesting interrupt overwrites EPC, and SRSCtl.PSS if it runs on a
+    shadow set as well, so both are saved before interrupts are enabled. */
+    mfc0        k0, _CP0_EPC
+    sw          k0, portSRS_EPC_STACK_LOCATION(sp)
+    mfc0        k0, _CP0_SRSCTL
+    sw          k0, portSRS_SRSCTL_STACK_LOCATION(sp)
+
+    mfc0        k0, _CP0_CAUSE
+    mfc0        k1, _CP0_STATUS
+    sw          k1, portSRS_STATUS_STACK_LOCATION(sp)
+
+    /* Prepare to enable interrupts above the current priority. */
+    srl         k0, k0, 0xa
+    ins         k1, k0, 10, 7
+    srl         k0, k0, 0x7 /* This copies the MSB of the IPL, but it would be an error if it was set anyway. */
+    ins         k1, k0, 18, 1
+    ins         k1, zero, 1, 4
+
+    /* Re-enable interrupts. */
+    mtc0        k1, _CP0_STATUS
+
+    /* The accumulators are shared by all register sets. */
+    mfhi        k0, $ac0
+    sw          k0, 20(sp)
+    mflo        k0, $ac0
+    sw          k0, 16(sp)
+
+    mfhi        k0, $ac1
+    sw          k0, 28(sp)
+    mflo        k0, $ac1
+    sw          k0, 24(sp)
+
+    mfhi        k0, $ac2
+    sw          k0, 36(sp)
+    mflo        k0, $ac2
+    sw          k0, 32(sp)
+
+    mfhi        k0, $ac3
+    sw          k0, 44(sp)
+    mflo        k0, $ac3
+    sw          k0, 40(sp)
+
+    rddsp       k0
+    sw          k0, portSRS_DSPCONTROL_STACK_LOCATION(sp)
+
+    .endm
+
+/******************************************************************/
+.macro  portRESTORE_CONTEXT_SRS
+
+    /* A yield asked for by the handler is pended on the core software
+    interrupt like from any other interrupt, and taken on the normal
+    register set once this one returns. */
+    lw          k0, 20(sp)
+    mthi        k0, $ac0
+    lw          k0, 16(sp)
+    mtlo        k0, $ac0
+
+    lw          k0, 28(sp)
+    mthi        k0, $ac1
+    lw          k0, 24(sp)
+    mtlo        k0, $ac1
+
+    lw          k0, 36(sp)
+    mthi        k0, $ac2
+    lw          k0, 32(sp)
+    mtlo        k0, $ac2
+
+    lw          k0, 44(sp)
+    mthi        k0, $ac3
+    lw          k0, 40(sp)
+    mtlo        k0, $ac3
+
+    lw          k0, portSRS_DSPCONTROL_STACK_LOCATION(sp)
+    wrdsp       k0
+
+    /* Protect access to the k registers, and others. */
+    di
+    ehb
+
+    /* Decrement the nesting count. */
+    la          k0, uxInterruptNesting
+    lw          k1, (k0)
+    addiu       k1, k1, -1
+    sw          k1, 0(k0)
+
+    /* Restore PSS so eret returns to the register set that was interrupted.
+    sp of the shadow set is not restored, the next entry loads it again. */
+    lw          k0, portSRS_SRSCTL_STACK_LOCATION(sp)
+    mtc0        k0, _CP0_SRSCTL
+
+    lw          k0, portSRS_STATUS_STACK_LOCATION(sp)
+    lw          k1, portSRS_EPC_STACK_LOCATION(sp)
+    mtc0        k0, _CP0_STATUS
+    mtc0        k1, _CP0_EPC
+    ehb
+    eret
+    nop
+
+    .endm
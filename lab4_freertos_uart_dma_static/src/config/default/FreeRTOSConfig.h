@@ -296,6 +296,12 @@
  * See https://www.freertos.org/RTOS-Cortex-M3-M4.html for information specific to
  * ARM Cortex-M devices. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY    (3)
+/* Interrupts from configSHADOW_REGISTER_ISR_PRIORITY up run on shadow register
+ * sets and only save EPC, STATUS, SRSCtl and the accumulators on entry.  DMA2,
+ * UART6_TX and the tick are at priority 2 for that. */
+#define configUSE_SHADOW_REGISTER_ISR           1
+#define configSHADOW_REGISTER_ISR_PRIORITY      (2)
+#define configTICK_INTERRUPT_PRIORITY           (2)
 
 /* Another name for configMAX_SYSCALL_INTERRUPT_PRIORITY - the name used depends
  * on the FreeRTOS port. */
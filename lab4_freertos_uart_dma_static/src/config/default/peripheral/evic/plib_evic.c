@@ -55,9 +55,14 @@ void EVIC_Initialize( void )
 {
     INTCONSET = _INTCON_MVEC_MASK;
 
+    /* Priorities 2 to 7 on shadow register sets 2 to 7, as
+       configSHADOW_REGISTER_ISR_PRIORITY asks.  Done before interrupts are
+       enabled, the SRS wrappers of DMA2, UART6_TX and the tick rely on it. */
+    PRISS = 0x76543200U;
+
     /* Set up priority and subpriority of enabled interrupts */
-    IPC34SET = 0x4U | 0x0U;  /* DMA2:  Priority 1 / Subpriority 0 */
-    IPC47SET = 0x40000U | 0x0U;  /* UART6_TX:  Priority 1 / Subpriority 0 */
+    IPC34SET = 0x8U | 0x0U;  /* DMA2:  Priority 2 / Subpriority 0 */
+    IPC47SET = 0x80000U | 0x0U;  /* UART6_TX:  Priority 2 / Subpriority 0 */
 
 
 }
@@ -0,0 +1,144 @@
+/*******************************************************************************
+  System DMA Transfer And Wait Service
+
+  File Name:
+    sys_dma_wait.c
+
+  Summary:
+    Starts a DMAC transfer and blocks the calling task until it completes.
+
+  Description:
+    The waiting task is handed over in a critical section: the interrupt
+    takes it and clears it, a timeout clears it after disabling the channel.
+    Whichever side finds it set owns the end of the transfer, so a transfer
+    that completes just as the wait times out is reported as complete, and
+    an interrupt that arrives after the cancel finds no task to wake.
+
+    A notification that was given just after the timeout is still pending
+    on the index; it is dropped before the next transfer starts.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sys_dma_wait.h"
+
+#if (SYS_DMA_WAIT_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES)
+    #error SYS_DMA_WAIT_NOTIFY_INDEX must be below configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Task blocked on the transfer, NULL once it is over */
+    TaskHandle_t waiter;
+
+    /* How the last transfer ended */
+    DMAC_TRANSFER_EVENT event;
+
+    uint32_t completeCount;
+
+} SYS_DMA_WAIT_OBJECT;
+
+static SYS_DMA_WAIT_OBJECT sysDmaWaitObj[DMAC_NUMBER_OF_CHANNELS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_DMA_WaitEventHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    SYS_DMA_WAIT_OBJECT *obj = &sysDmaWaitObj[context];
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t count = _CP0_GET_COUNT();
+    UBaseType_t uxSavedStatus;
+    TaskHandle_t waiter;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) == 0U)
+    {
+        return;
+    }
+
+    uxSavedStatus = taskENTER_CRITICAL_FROM_ISR();
+
+    waiter = obj->waiter;
+    if (waiter != NULL)
+    {
+        obj->waiter = NULL;
+        obj->event = event;
+        obj->completeCount = count;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedStatus);
+
+    if (waiter != NULL)
+    {
+        vTaskNotifyGiveIndexedFromISR(waiter, SYS_DMA_WAIT_NOTIFY_INDEX, &xHigherPriorityTaskWoken);
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+DMAC_TRANSFER_EVENT SYS_DMA_ChannelTransferAndWait( DMAC_CHANNEL channel,
+                                                    const void *srcAddr, size_t srcSize,
+                                                    const void *destAddr, size_t destSize,
+                                                    size_t cellSize, TickType_t xTicksToWait )
+{
+    SYS_DMA_WAIT_OBJECT *obj;
+
+    configASSERT(channel < DMAC_NUMBER_OF_CHANNELS);
+
+    obj = &sysDmaWaitObj[channel];
+    configASSERT(obj->waiter == NULL);
+
+    (void)ulTaskNotifyTakeIndexed(SYS_DMA_WAIT_NOTIFY_INDEX, pdTRUE, 0);
+
+    obj->event = DMAC_TRANSFER_EVENT_NONE;
+    obj->waiter = xTaskGetCurrentTaskHandle();
+    DMAC_ChannelCallbackRegister(channel, SYS_DMA_WaitEventHandler, (uintptr_t)channel);
+
+    if (DMAC_ChannelTransfer(channel, srcAddr, srcSize, destAddr, destSize, cellSize) == false)
+    {
+        obj->waiter = NULL;
+        return DMAC_TRANSFER_EVENT_ERROR;
+    }
+
+    if (ulTaskNotifyTakeIndexed(SYS_DMA_WAIT_NOTIFY_INDEX, pdTRUE, xTicksToWait) == 0U)
+    {
+        /* Timed out, stop the channel unless the interrupt got there first */
+        taskENTER_CRITICAL();
+        if (obj->waiter != NULL)
+        {
+            DMAC_ChannelDisable(channel);
+            obj->waiter = NULL;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return obj->event;
+}
+
+uint32_t SYS_DMA_ChannelCompleteCount( DMAC_CHANNEL channel )
+{
+    configASSERT(channel < DMAC_NUMBER_OF_CHANNELS);
+
+    return sysDmaWaitObj[channel].completeCount;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+  System DMA Transfer And Wait Service
+
+  File Name:
+    sys_dma_wait.h
+
+  Summary:
+    Starts a DMAC transfer and blocks the calling task until it completes.
+
+  Description:
+    The usual way to wait for a transfer is a binary semaphore per channel,
+    given from the channel callback.  The give walks the semaphore's list of
+    waiting tasks inside queue.c, and the semaphore is one more object to
+    create and keep in step with the channel.
+
+    Here the channel remembers the task waiting on it and the channel
+    interrupt wakes it with a direct to task notification on its own index,
+    so nothing is created and the wake is a single notify.  A transfer that
+    does not complete within the block time is cancelled by disabling the
+    channel.
+
+    The service registers its own callback on the channel for each
+    transfer, so a channel is either used through this service or with a
+    callback of the application, not both at once.  Only one task waits on
+    a channel at a time; tasks sharing a channel still need a mutex.
+*******************************************************************************/
+
+#ifndef SYS_DMA_WAIT_H
+#define SYS_DMA_WAIT_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "peripheral/dmac/plib_dmac.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Notification index the waiting task blocks on.  The last one by default,
+   index 0 is the one the plain xTaskNotify calls use. */
+#ifndef SYS_DMA_WAIT_NOTIFY_INDEX
+    #define SYS_DMA_WAIT_NOTIFY_INDEX   (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    DMAC_TRANSFER_EVENT SYS_DMA_ChannelTransferAndWait( DMAC_CHANNEL channel,
+                            const void *srcAddr, size_t srcSize,
+                            const void *destAddr, size_t destSize,
+                            size_t cellSize, TickType_t xTicksToWait )
+
+  Summary:
+    DMAC_ChannelTransfer, then waits up to xTicksToWait for the transfer.
+
+  Description:
+    Called from a task.  A source in cached memory must be clean, as for
+    DMAC_ChannelTransfer.
+
+  Returns:
+    DMAC_TRANSFER_EVENT_COMPLETE when the transfer is done,
+    DMAC_TRANSFER_EVENT_ERROR if it was aborted or the channel was busy,
+    DMAC_TRANSFER_EVENT_NONE if it timed out and was cancelled.
+*/
+DMAC_TRANSFER_EVENT SYS_DMA_ChannelTransferAndWait( DMAC_CHANNEL channel,
+                                                    const void *srcAddr, size_t srcSize,
+                                                    const void *destAddr, size_t destSize,
+                                                    size_t cellSize, TickType_t xTicksToWait );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_DMA_ChannelCompleteCount( DMAC_CHANNEL channel )
+
+  Summary:
+    Core timer count taken in the interrupt of the last finished transfer.
+
+  Description:
+    The difference to _CP0_GET_COUNT() once SYS_DMA_ChannelTransferAndWait
+    returned is the time from the interrupt to the task running again.
+*/
+uint32_t SYS_DMA_ChannelCompleteCount( DMAC_CHANNEL channel );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DMA_WAIT_H
@@ -17,7 +17,7 @@
  *		UART TX
  *		FreeRTOS
  *		Mutex
- *		Binary Semaphore
+ *		Binary Semaphore or Task Notification
 
   Summary:
     Task are the primary components of FreeRTOS. They can be dynamic tasks or static tasks. 
@@ -48,8 +48,24 @@
 #include "task.h"
 #include "device_cache.h"
 #include "semphr.h"
+#include "system/dma/sys_dma_wait.h"
 #include <xc.h>
 
+//wait for the end of a DMA2 transfer with a task notification from the channel interrupt (1)
+//or with the binary semaphore given by U6D2Handler (0), to compare how fast the task wakes up
+#define U6D2_WAIT_NOTIFY    1
+#define U6D2_TIMEOUT        100
+
+//the core timer runs at half the cpu clock
+#define CORE_TIMER_NS(count)    ((uint32_t)(((uint64_t)(count) * 2000000000U) / CPU_CLOCK_FREQUENCY))
+#define CORE_TIMER_CYCLES(count)    ((count) * 2U)
+
+//ISR entry and exit are timed on core software interrupt 1, at the priority of DMA2 and UART6_TX
+//so it runs on a shadow register set when configUSE_SHADOW_REGISTER_ISR is 1
+#define ISR_BENCH_PRIORITY  2
+#define ISR_BENCH_RUNS      64
+#define CORE_SW_1           0x00000200U
+
 static StackType_t xTaskHighTCBBuffer[configMINIMAL_STACK_SIZE];
 static StackType_t xTaskLowTCBBuffer[configMINIMAL_STACK_SIZE];
 
@@ -60,7 +76,6 @@ static void prvTaskHighFunction(void * pvParams);
 static void prvTaskLowFunction(void * pvParams);
 
 static SemaphoreHandle_t xU6D2Mutex = NULL;
-static SemaphoreHandle_t xU6D2Bin = NULL;
 
 static uint8_t __attribute__ ((aligned (16))) U6TxBuffer[100] = {0};
 
@@ -68,9 +83,15 @@ volatile bool u6d2Error = false;
 volatile bool u6d2None = false;
 volatile bool u6d2Half = false;
 
+#if (U6D2_WAIT_NOTIFY == 0)
+//the binary semaphore path, U6D2Handler is registered for DMA2 only when it is built
+static SemaphoreHandle_t xU6D2Bin = NULL;
+volatile uint32_t u6d2CompleteCount = 0;
+
 static void U6D2Handler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
     if (event == DMAC_TRANSFER_EVENT_COMPLETE){        
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        u6d2CompleteCount = _CP0_GET_COUNT();
         xSemaphoreGiveFromISR(xU6D2Bin, &xHigherPriorityTaskWoken);
         portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);        
     } 
@@ -83,6 +104,79 @@ static void U6D2Handler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
     } 
         else u6d2Half = true;
 }
+#endif
+
+//send U6TxBuffer on UART6 through DMA2 and wait for the end of the transfer
+//returns the time from the DMA2 interrupt to the task running again in core timer counts, 0 on failure
+static uint32_t prvU6D2Send(void){
+    size_t length = strlen((const char *) U6TxBuffer);
+    DCACHE_CLEAN_BY_ADDR(
+                                                (uint32_t) U6TxBuffer,
+                                                length);
+#if (U6D2_WAIT_NOTIFY == 1)
+    if (SYS_DMA_ChannelTransferAndWait(
+                                                DMAC_CHANNEL_2,
+                                                (const void *) U6TxBuffer,
+                                                length,
+                                                (const void *) &U6TXREG, 1, 1,
+                                                pdMS_TO_TICKS(U6D2_TIMEOUT)) != DMAC_TRANSFER_EVENT_COMPLETE){
+        u6d2Error = true;
+        return 0;
+    }
+    return _CP0_GET_COUNT() - SYS_DMA_ChannelCompleteCount(DMAC_CHANNEL_2);
+#else
+    DMAC_ChannelTransfer(
+                                                DMAC_CHANNEL_2,
+                                                (const void *) U6TxBuffer,
+                                                length,
+                                                (const void *) &U6TXREG, 1, 1);
+    if (xSemaphoreTake(xU6D2Bin, pdMS_TO_TICKS(U6D2_TIMEOUT)) != pdTRUE){
+        DMAC_ChannelDisable(DMAC_CHANNEL_2);
+        u6d2Error = true;
+        return 0;
+    }
+    return _CP0_GET_COUNT() - u6d2CompleteCount;
+#endif
+}
+//core timer count at the start of CORE_SOFTWARE_1_Handler, 0 until it runs
+static volatile uint32_t ulBenchHandlerCount = 0;
+
+void __attribute__((used)) CORE_SOFTWARE_1_Handler(void){
+    ulBenchHandlerCount = _CP0_GET_COUNT();
+    _CP0_BIC_CAUSE(CORE_SW_1);
+    IFS0CLR = _IFS0_CS1IF_MASK;
+}
+
+//raise core software interrupt 1 ISR_BENCH_RUNS times, keep the fastest entry (request to handler)
+//and exit (handler back to the task) in core timer counts, the tick or DMA2 only make a run slower
+static void prvISRBenchmark(uint32_t * entry, uint32_t * exit){
+    uint32_t start, end;
+    *entry = UINT32_MAX;
+    *exit = UINT32_MAX;
+
+    IFS0CLR = _IFS0_CS1IF_MASK;
+    IPC0CLR = _IPC0_CS1IP_MASK;
+    IPC0SET = (ISR_BENCH_PRIORITY << _IPC0_CS1IP_POSITION);
+    IEC0SET = _IEC0_CS1IE_MASK;
+
+    for (uint32_t run = 0; run < ISR_BENCH_RUNS; run++){
+        ulBenchHandlerCount = 0;
+        start = _CP0_GET_COUNT();
+        _CP0_BIS_CAUSE(CORE_SW_1);
+        while (ulBenchHandlerCount == 0);
+        end = _CP0_GET_COUNT();
+
+        if ((ulBenchHandlerCount - start) < *entry){
+            *entry = ulBenchHandlerCount - start;
+        }
+        if ((end - ulBenchHandlerCount) < *exit){
+            *exit = end - ulBenchHandlerCount;
+        }
+    }
+
+    IEC0CLR = _IEC0_CS1IE_MASK;
+}
+
 //debug messages is written directly to U6TXREG
 static void Debug_msg(char * msg){
 	while (*msg){
@@ -106,12 +200,14 @@ int main ( void )
     Debug_msg("Lab04-FreeRTOS on UART6 via DMA2\r\n");
    
     xU6D2Mutex = xSemaphoreCreateMutex();
+#if (U6D2_WAIT_NOTIFY == 0)
     xU6D2Bin = xSemaphoreCreateBinary();
 
      DMAC_ChannelCallbackRegister(
                                                                 DMAC_CHANNEL_2,
                                                                 U6D2Handler,
                                                                 0);
+#endif
     //create Task High - statically 
     TaskHandle_t xTaskStaticResult = NULL;
     xTaskStaticResult = xTaskCreateStatic(
@@ -155,20 +251,28 @@ int main ( void )
 
 static void prvTaskHighFunction(void * pvParams){
     (void ) pvParams;
+    //wake up time of the previous transfer, shown with the next message
+    uint32_t wake = 0;
+    uint32_t entry, exit;
+
+    prvISRBenchmark(&entry, &exit);
+    if (xSemaphoreTake(xU6D2Mutex, portMAX_DELAY) == pdTRUE)
+    {
+        sprintf((char *)U6TxBuffer, "   ISR entry %lu cycles, exit %lu cycles, shadow registers %d\r\n",
+                                                                        (unsigned long)CORE_TIMER_CYCLES(entry),
+                                                                        (unsigned long)CORE_TIMER_CYCLES(exit),
+                                                                        configUSE_SHADOW_REGISTER_ISR);
+        (void)prvU6D2Send();
+
+        xSemaphoreGive(xU6D2Mutex);
+    }
+
     for (uint8_t high=0; high < 5; high++){
                 if (xSemaphoreTake(xU6D2Mutex, portMAX_DELAY) == pdTRUE)
                 {
-                    sprintf((char *)U6TxBuffer, "   task High take mutex and running ..\r\n");                   
-                    DCACHE_CLEAN_BY_ADDR(  
-                                                                        (uint32_t) U6TxBuffer,
-                                                                        strlen((const char *) U6TxBuffer));                
-                    DMAC_ChannelTransfer(
-                                                            DMAC_CHANNEL_2,
-                                                            (const void *) U6TxBuffer,
-                                                            strlen((const char *) U6TxBuffer),
-                                                            (const void *) &U6TXREG, 1, 1);
-                
-                    xSemaphoreTake(xU6D2Bin, portMAX_DELAY);
+                    sprintf((char *)U6TxBuffer, "   task High take mutex and running .. woke in %lu ns\r\n",
+                                                                        (unsigned long)CORE_TIMER_NS(wake));
+                    wake = prvU6D2Send();
 
                     xSemaphoreGive(xU6D2Mutex);
                 }
@@ -179,19 +283,14 @@ static void prvTaskHighFunction(void * pvParams){
 
 static void prvTaskLowFunction(void * pvParams){
     (void) pvParams;
+    //wake up time of the previous transfer, shown with the next message
+    uint32_t wake = 0;
     for (uint8_t low = 0; low < 5 ; low++){
                 if (xSemaphoreTake(xU6D2Mutex, portMAX_DELAY) == pdTRUE)
                 {                  
-                    sprintf((char *)U6TxBuffer, "   task Low take mutex and running ..\r\n");
-                    DCACHE_CLEAN_BY_ADDR(
-                                                                        (uint32_t) U6TxBuffer,
-                                                                        strlen((const char *) U6TxBuffer));                  
-                    DMAC_ChannelTransfer(
-                                                            DMAC_CHANNEL_2,
-                                                            (const void *) U6TxBuffer,
-                                                            strlen((const char *) U6TxBuffer),
-                                                            (const void *) &U6TXREG, 1, 1);
-                    xSemaphoreTake(xU6D2Bin, portMAX_DELAY);
+                    sprintf((char *)U6TxBuffer, "   task Low take mutex and running .. woke in %lu ns\r\n",
+                                                                        (unsigned long)CORE_TIMER_NS(wake));
+                    wake = prvU6D2Send();
 
                     xSemaphoreGive(xU6D2Mutex);
                 }                
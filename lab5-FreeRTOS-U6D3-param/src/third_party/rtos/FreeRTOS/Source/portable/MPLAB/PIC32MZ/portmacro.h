@@ -146,8 +146,8 @@ extern void vPortClearInterruptMaskFromISR( UBaseType_t );
 #define portSET_INTERRUPT_MASK_FROM_ISR() uxPortSetInterruptMaskFromISR()
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusRegister ) vPortClearInterruptMaskFromISR( uxSavedStatusRegister )
 
-#if ( __mips_hard_float == 0 ) && ( configUSE_TASK_FPU_SUPPORT == 1 )
-    #error configUSE_TASK_FPU_SUPPORT can only be set to 1 when the part supports a hardware FPU module.
+#if ( __mips_hard_float == 0 ) && ( configUSE_TASK_FPU_SUPPORT != 0 )
+    #error configUSE_TASK_FPU_SUPPORT can only be set to 1 or 2 when the part supports a hardware FPU module.
 #endif
 
 #if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 1 )
@@ -155,6 +155,15 @@ extern void vPortClearInterruptMaskFromISR( UBaseType_t );
     #define portTASK_USES_FLOATING_POINT() vPortTaskUsesFPU()
 #endif
 
+/* With configUSE_TASK_FPU_SUPPORT set to 2 every task may use the FPU without
+registering.  The FPU is switched lazily: a task only gets it enabled once it
+executes an FP instruction, and the registers are only saved and loaded when a
+different task did so last.  The FPU owner is forgotten when it is deleted. */
+#if ( __mips_hard_float == 1 ) && ( configUSE_TASK_FPU_SUPPORT == 2 )
+    void vPortCleanUpTCB( void *pxTCB );
+    #define portCLEAN_UP_TCB( pxTCB ) vPortCleanUpTCB( pxTCB )
+#endif
+
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
 #endif
@@ -193,6 +202,12 @@ uint32_t ulCause;                               \
 extern volatile UBaseType_t uxInterruptNesting;
 #define portASSERT_IF_IN_ISR() configASSERT( uxInterruptNesting == 0 )
 
+/* Tickless idle, stretches the Timer 1 period up to the next unblock time. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 #define portNOP()   __asm volatile ( "nop" )
 
 /*-----------------------------------------------------------*/
@@ -50,6 +50,7 @@
 // *****************************************************************************
 #include "interrupts.h"
 #include "definitions.h"
+#include "system/uart_tx/sys_uart_tx.h"
 
 
 
@@ -96,7 +97,7 @@ void __attribute__((used)) UART6_RX_Handler (void)
 
 void __attribute__((used)) UART6_TX_Handler (void)
 {
-    UART6_TX_InterruptHandler();
+    SYS_UART_TX_InterruptHandler();
 }
 
 
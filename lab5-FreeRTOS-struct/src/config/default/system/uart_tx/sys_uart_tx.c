@@ -0,0 +1,139 @@
+/*******************************************************************************
+  System UART Transmit Service
+
+  File Name:
+    sys_uart_tx.c
+
+  Summary:
+    Interrupt driven UART6 transmit through a FreeRTOS stream buffer.
+
+  Description:
+    UART6_Initialize sets UTXISEL = 10: the TX interrupt is pending as long
+    as the transmit FIFO is completely empty.  The handler can therefore
+    write 8 characters without looking at UTXBF, and the flag stays clear
+    until the last of them has moved into the shift register.
+
+    A stream buffer allows one writer at a time, tasks are serialized by a
+    mutex which also keeps each write in one piece.  The interrupt is the
+    only reader.  Writers enable the interrupt after adding data, the
+    handler disables it when it finds nothing to send; on a single core the
+    handler cannot run between the check and the disable, so no wake up is
+    lost.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "device.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "sys_uart_tx.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Depth of the UART transmit FIFO */
+#define SYS_UART_TX_FIFO_DEPTH      (8U)
+
+static StreamBufferHandle_t sysUartTxStream;
+static SemaphoreHandle_t sysUartTxMutex;
+
+static uint8_t sysUartTxStorage[SYS_UART_TX_BUFFER_SIZE + 1U];
+static StaticStreamBuffer_t sysUartTxStreamObj;
+static StaticSemaphore_t sysUartTxMutexObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_UART_TX_Initialize( void )
+{
+    sysUartTxStream = xStreamBufferCreateStatic(sizeof(sysUartTxStorage), 1,
+                                                sysUartTxStorage, &sysUartTxStreamObj);
+    sysUartTxMutex = xSemaphoreCreateMutexStatic(&sysUartTxMutexObj);
+}
+
+size_t SYS_UART_TX_Write( const void *buffer, size_t size, TickType_t timeout )
+{
+    const uint8_t *data = (const uint8_t *)buffer;
+    TimeOut_t timeOut;
+    size_t sent = 0U;
+
+    vTaskSetTimeOutState(&timeOut);
+
+    if (xSemaphoreTake(sysUartTxMutex, timeout) == pdFALSE)
+    {
+        return 0U;
+    }
+
+    (void)xTaskCheckForTimeOut(&timeOut, &timeout);
+
+    while (sent < size)
+    {
+        /* A piece larger than the ring would never find room */
+        size_t chunk = ((size - sent) > SYS_UART_TX_BUFFER_SIZE) ? SYS_UART_TX_BUFFER_SIZE : (size - sent);
+        size_t count = xStreamBufferSend(sysUartTxStream, &data[sent], chunk, timeout);
+
+        if (count > 0U)
+        {
+            IEC5SET = _IEC5_U6TXIE_MASK;
+            sent += count;
+        }
+
+        if ((count < chunk) && (xTaskCheckForTimeOut(&timeOut, &timeout) == pdTRUE))
+        {
+            break;
+        }
+    }
+
+    (void)xSemaphoreGive(sysUartTxMutex);
+
+    return sent;
+}
+
+size_t SYS_UART_TX_Print( const char *string )
+{
+    return SYS_UART_TX_Write(string, strlen(string), portMAX_DELAY);
+}
+
+bool SYS_UART_TX_IsIdle( void )
+{
+    return ((xStreamBufferIsEmpty(sysUartTxStream) == pdTRUE) &&
+            ((U6STA & _U6STA_TRMT_MASK) != 0U));
+}
+
+void SYS_UART_TX_InterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint8_t burst[SYS_UART_TX_FIFO_DEPTH];
+    size_t count;
+    size_t index;
+
+    count = xStreamBufferReceiveFromISR(sysUartTxStream, burst, sizeof(burst),
+                                        &xHigherPriorityTaskWoken);
+
+    for (index = 0U; index < count; index++)
+    {
+        U6TXREG = burst[index];
+    }
+
+    if (count == 0U)
+    {
+        IEC5CLR = _IEC5_U6TXIE_MASK;
+    }
+
+    IFS5CLR = _IFS5_U6TXIF_MASK;
+
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,125 @@
+/*******************************************************************************
+  System UART Transmit Service
+
+  File Name:
+    sys_uart_tx.h
+
+  Summary:
+    Interrupt driven UART6 transmit through a FreeRTOS stream buffer.
+
+  Description:
+    Tasks append to a stream buffer and go on, they block only while it is
+    full.  The UART6 TX interrupt is raised when the hardware FIFO runs
+    empty and refills all 8 places at once, so one interrupt is taken per 8
+    characters instead of one per character.  When the stream buffer runs
+    dry the interrupt is switched off until the next write.
+
+    The service owns UART6 TX: UART6_Write of the plib must not be used and
+    UART6_TX_Handler must call SYS_UART_TX_InterruptHandler.
+*******************************************************************************/
+
+#ifndef SYS_UART_TX_H
+#define SYS_UART_TX_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bytes the stream buffer holds between the tasks and the TX interrupt. */
+#ifndef SYS_UART_TX_BUFFER_SIZE
+    #define SYS_UART_TX_BUFFER_SIZE     (512U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_UART_TX_Initialize( void )
+
+  Summary:
+    Creates the stream buffer and the writer mutex.
+
+  Description:
+    Call after UART6_Initialize and before the first write.
+*/
+void SYS_UART_TX_Initialize( void );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_UART_TX_Write( const void *buffer, size_t size, TickType_t timeout )
+
+  Summary:
+    Appends size bytes to the transmit ring.
+
+  Description:
+    Task context only, the scheduler must be running unless timeout is 0.
+    Several tasks may write, each write reaches the line in one piece.
+    Returns as soon as the data is in the ring; waits at most timeout for
+    room when the ring is full.
+
+  Returns:
+    Number of bytes queued, less than size if the timeout expired.
+*/
+size_t SYS_UART_TX_Write( const void *buffer, size_t size, TickType_t timeout );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_UART_TX_Print( const char *string )
+
+  Summary:
+    SYS_UART_TX_Write for a NUL terminated string, waits as long as needed.
+*/
+size_t SYS_UART_TX_Print( const char *string );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_UART_TX_IsIdle( void )
+
+  Summary:
+    true once everything written has left the shift register.
+*/
+bool SYS_UART_TX_IsIdle( void );
+
+// *****************************************************************************
+/* Function:
+    void SYS_UART_TX_InterruptHandler( void )
+
+  Summary:
+    UART6 TX interrupt, called from UART6_TX_Handler.
+*/
+void SYS_UART_TX_InterruptHandler( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_UART_TX_H
@@ -12,12 +12,10 @@
 	Inputs: N/A
 	Outputs: built-in debug via com port/UART6
 	Labs objects:
-		DMA
 		Static Task (prvTaskFunction)
- *		UART TX
+ *		UART TX interrupt
  *		FreeRTOS
- *		Mutex
- *		Binary Semaphore
+ *		Stream Buffer (sys_uart_tx)
  *		Custom struct
 
   Summary:
@@ -28,7 +26,8 @@
   Description:
     This file contains the "main" function for a project.  The "main" function calls the "SYS_Initialize" function to 
  * initialize the state machines of all modules in the system. Debug messages are showed via UART6. 
- * DMA module is using to make the task/CPU unblock and transmission continues in background.
+ * Messages are queued in a stream buffer and the UART6 TX interrupt sends them in background,
+ * 8 characters per interrupt.
  *******************************************************************************/
 
 // *****************************************************************************
@@ -47,8 +46,7 @@
 #include <stdint.h>
 #include "FreeRTOS.h"
 #include "task.h"
-#include "device_cache.h"
-#include "semphr.h"
+#include "system/uart_tx/sys_uart_tx.h"
 
 static StackType_t xTaskLKTcbBuffer[configMINIMAL_STACK_SIZE];
 static StackType_t xTaskNPTcbBuffer[configMINIMAL_STACK_SIZE];
@@ -59,11 +57,6 @@ static StaticTask_t xTaskNPStaticBuffer;
 static void prvTaskLKFunction(void * pvParams);
 static void prvTaskNPFunction(void * pvParams);
 
-static SemaphoreHandle_t xMutex = NULL;
-static SemaphoreHandle_t xBinarySem = NULL;
-
-static uint8_t __attribute__ ((aligned (16))) u6TxBuffer[256] = {0};
-
 typedef struct strParams_t{
                                         char msg[100];
                                         char name[20];
@@ -82,14 +75,6 @@ static strParams_t npParams = {
                             .status = pdTRUE,
                             .StackFree = 0};
 
-static void U6D5Handler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
-    if (event == DMAC_TRANSFER_EVENT_COMPLETE){
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xSemaphoreGiveFromISR(xBinarySem, &xHigherPriorityTaskWoken);
-        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
-    }
-}
-
 static void Debug_msg(char * msg){
 	while (*msg){
 		while (U6STAbits.UTXBF);
@@ -110,14 +95,9 @@ int main ( void )
     SYS_Initialize ( NULL );
 
     Debug_msg("Lab5-pass a struct to a task at creation \r\n");
-        
-    DMAC_ChannelCallbackRegister(
-            DMAC_CHANNEL_5,
-            U6D5Handler,
-            0);
     
-    xMutex =  xSemaphoreCreateMutex();
-    xBinarySem = xSemaphoreCreateBinary();
+    //create the tx ring, the tasks append their messages and continue
+    SYS_UART_TX_Initialize();
     
     TaskHandle_t xTaskLKCreateResult = xTaskCreateStatic(
                                                                                             prvTaskLKFunction,
@@ -162,31 +142,16 @@ int main ( void )
 static void prvTaskLKFunction(void * pvParams){
     strParams_t * locallk = (strParams_t *) pvParams;
     for (uint8_t lk=0; lk < 5; lk++){
-        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-            locallk->status = (locallk->status == pdTRUE) ? pdFALSE : pdTRUE; //ternary operator
-            sprintf((char *)u6TxBuffer, "%s %s and %d \r\n", locallk->msg, locallk->name, locallk->status);
-            DCACHE_CLEAN_BY_ADDR(
-                                                                (uint32_t)u6TxBuffer,
-                                                                strlen((const char *) u6TxBuffer));
-            DMAC_ChannelTransfer(
-                                                    DMAC_CHANNEL_5,
-                                                    (const void *)u6TxBuffer,
-                                                    strlen((const char *)u6TxBuffer),
-                                                    (const void *)&U6TXREG, 1, 1);
-            
-            xSemaphoreTake(xBinarySem, portMAX_DELAY);
-            
-            xSemaphoreGive(xMutex);
-        }
+        char lkMsgArray[150] = {0};
+        locallk->status = (locallk->status == pdTRUE) ? pdFALSE : pdTRUE; //ternary operator
+        sprintf(lkMsgArray, "%s %s and %d \r\n", locallk->msg, locallk->name, locallk->status);
+        SYS_UART_TX_Print(lkMsgArray); //each write goes out in one piece, no mutex needed
         char lkFreeArray[50] = {0};
         BaseType_t lkStackFree = uxTaskGetStackHighWaterMark(NULL); // monitor stack usage of stack LK
         locallk->StackFree = (unsigned int)lkStackFree;
         char * lkFree = lkFreeArray;
         sprintf(lkFree, "  task LK has left %u words in stack \r\n ", locallk->StackFree);
-	if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-		Debug_msg(lkFree);
-		xSemaphoreGive(xMutex);
-	}
+	SYS_UART_TX_Print(lkFree);
 	
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -196,33 +161,17 @@ static void prvTaskNPFunction(void * pvParams){
     strParams_t * localnp = (strParams_t *)pvParams;
     
     for (uint8_t np=0; np < 5; np++){
-        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-            localnp->status = (localnp->status == pdTRUE) ? pdFALSE : pdTRUE; //ternary operator (? :)
-            sprintf((char *) u6TxBuffer, "%s %s and %s \r\n", localnp->msg, localnp->name, 
-                                                                                    (localnp->status == pdTRUE) ? "true" : "false");
-            DCACHE_CLEAN_BY_ADDR (
-                                                                    (uint32_t) u6TxBuffer,
-                                                                    strlen((const char *) u6TxBuffer));
-            DMAC_ChannelTransfer(
-                                                    DMAC_CHANNEL_5,
-                                                    (const void *) u6TxBuffer,
-                                                    strlen((const char *)u6TxBuffer),
-                                                    (const void *) &U6TXREG, 1, 1);
-            
-            xSemaphoreTake(xBinarySem, portMAX_DELAY);
-            
-            xSemaphoreGive(xMutex);
-                    
-        }
+        char npMsgArray[150] = {0};
+        localnp->status = (localnp->status == pdTRUE) ? pdFALSE : pdTRUE; //ternary operator (? :)
+        sprintf(npMsgArray, "%s %s and %s \r\n", localnp->msg, localnp->name, 
+                                                                                (localnp->status == pdTRUE) ? "true" : "false");
+        SYS_UART_TX_Print(npMsgArray);
         char npArrayMsg[50] = {0};
         BaseType_t npStackFree = uxTaskGetStackHighWaterMark(NULL);//monitor stack usage of task NP
         localnp->StackFree = (unsigned int) npStackFree;
         char * npStackMsg = npArrayMsg;
         sprintf(npStackMsg, "    task NP has left %u words in stack \r\n", localnp->StackFree);
-	if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-		Debug_msg(npStackMsg);
-		xSemaphoreGive(xMutex);
-	}
+	SYS_UART_TX_Print(npStackMsg);
 	 
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
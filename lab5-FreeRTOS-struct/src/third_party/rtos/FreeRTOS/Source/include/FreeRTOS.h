@@ -321,6 +321,10 @@
     #define configUSE_MUTEXES    0
 #endif
 
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
 #ifndef configUSE_TIMERS
     #define configUSE_TIMERS    0
 #endif
@@ -329,6 +333,10 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+#ifndef configUSE_EVENT_GROUP_DIRECT_ISR
+    #define configUSE_EVENT_GROUP_DIRECT_ISR    0
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
@@ -367,6 +375,14 @@
     #define configIDLE_SHOULD_YIELD    1
 #endif
 
+#ifndef configUSE_DELAYED_TASK_HEAP
+    #define configUSE_DELAYED_TASK_HEAP    0
+#endif
+
+#ifndef configDELAYED_TASK_HEAP_LENGTH
+    #define configDELAYED_TASK_HEAP_LENGTH    32
+#endif
+
 #if configMAX_TASK_NAME_LEN < 1
     #error configMAX_TASK_NAME_LEN must be set to a minimum of 1 in FreeRTOSConfig.h
 #endif
@@ -531,6 +547,22 @@
         #define portTIMER_CALLBACK_ATTRIBUTE
     #endif /* portTIMER_CALLBACK_ATTRIBUTE */
 
+    #ifndef configUSE_TIMER_WHEEL
+        #define configUSE_TIMER_WHEEL    0
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #ifndef configTIMER_WHEEL_SLOT_BITS
+        #define configTIMER_WHEEL_SLOT_BITS    6
+    #endif /* configTIMER_WHEEL_SLOT_BITS */
+
+    #ifndef configTIMER_WHEEL_LEVELS
+        #define configTIMER_WHEEL_LEVELS    4
+    #endif /* configTIMER_WHEEL_LEVELS */
+
+    #ifndef configTIMER_COMMAND_BATCH
+        #define configTIMER_COMMAND_BATCH    1
+    #endif /* configTIMER_COMMAND_BATCH */
+
 #endif /* configUSE_TIMERS */
 
 #ifndef portHAS_NESTED_INTERRUPTS
@@ -2734,6 +2766,10 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_MULTIPLE
+    #define configUSE_QUEUE_MULTIPLE    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2876,6 +2912,10 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
 #if ( ( configRUN_MULTIPLE_PRIORITIES == 0 ) && ( configUSE_TASK_PREEMPTION_DISABLE != 0 ) )
     #error configRUN_MULTIPLE_PRIORITIES must be set to 1 to use task preemption disable
 #endif
@@ -3261,6 +3301,10 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy10;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
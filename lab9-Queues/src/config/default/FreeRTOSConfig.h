@@ -384,6 +384,7 @@
 #define configUSE_RECURSIVE_MUTEXES             0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configUSE_QUEUE_SETS                    1
+#define configUSE_QUEUE_MULTIPLE                1
 #define configUSE_APPLICATION_TASK_TAG          0
 #define configUSE_TASK_FPU_SUPPORT              0
 
@@ -0,0 +1,313 @@
+/*******************************************************************************
+  System Deferred Log Service
+
+  File Name:
+    sys_dlog.c
+
+  Summary:
+    Binary log records posted by tasks, rendered later by a formatter task.
+
+  Description:
+    Every ring has a single producer task and the formatter task as its
+    single consumer, so head is only written by the producer and tail only by
+    the formatter; no critical section is needed on either side.  The
+    formatter packs as many records as fit into one buffer before starting a
+    DMA transfer, and sleeps on the DMAC completion while the bytes go out.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "device.h"
+#include "device_cache.h"
+#include "peripheral/cache/plib_cache.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "sys_dlog.h"
+
+#if ((SYS_DLOG_RING_DEPTH & (SYS_DLOG_RING_DEPTH - 1U)) != 0U)
+    #error SYS_DLOG_RING_DEPTH must be a power of two
+#endif
+
+#if ((SYS_DLOG_BUFFER_SIZE % 16U) != 0U)
+    #error SYS_DLOG_BUFFER_SIZE must be a multiple of the cache line size
+#endif
+
+#if (SYS_DLOG_MAX_ARGS > 4U)
+    #error SYS_DLOG_MAX_ARGS above 4 needs a longer argument list in SYS_DLOG_RenderText
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_DLOG_RING_MASK          (SYS_DLOG_RING_DEPTH - 1U)
+
+#define SYS_DLOG_FRAME_SYNC         (0xA5U)
+#define SYS_DLOG_FRAME_HEADER_SIZE  (4U)
+#define SYS_DLOG_FRAME_MAX_SIZE     (SYS_DLOG_FRAME_HEADER_SIZE + (4U * SYS_DLOG_MAX_ARGS))
+
+/* Keeps the record stores ahead of the index update that publishes them */
+#define SYS_DLOG_COMPILER_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+
+typedef struct
+{
+    const char * const *formats;
+    uint16_t formatCount;
+    SYS_DLOG_MODE mode;
+    DMAC_CHANNEL channel;
+
+    SYS_DLOG_RING *rings;
+
+    TaskHandle_t task;
+    SemaphoreHandle_t txDone;
+
+} SYS_DLOG_OBJECT;
+
+static SYS_DLOG_OBJECT sysDlogObj;
+
+static uint8_t __attribute__ ((aligned (16))) sysDlogBuffer[SYS_DLOG_BUFFER_SIZE];
+
+static StackType_t sysDlogTaskStack[SYS_DLOG_TASK_STACK_SIZE];
+static StaticTask_t sysDlogTaskTcb;
+static StaticSemaphore_t sysDlogTxDoneObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void SYS_DLOG_DmaHandler( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    (void)context;
+
+    if ((event & (DMAC_TRANSFER_EVENT_COMPLETE | DMAC_TRANSFER_EVENT_ERROR)) != 0U)
+    {
+        (void)xSemaphoreGiveFromISR(sysDlogObj.txDone, &xHigherPriorityTaskWoken);
+        portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    }
+}
+
+static void SYS_DLOG_Send( size_t size )
+{
+    DCACHE_CLEAN_BY_ADDR((uint32_t)sysDlogBuffer, size);
+
+    if (DMAC_ChannelTransfer(sysDlogObj.channel,
+                             (const void *)sysDlogBuffer, size,
+                             (const void *)&U6TXREG, 1, 1) == true)
+    {
+        (void)xSemaphoreTake(sysDlogObj.txDone, portMAX_DELAY);
+    }
+}
+
+/* Renders record at dst, returns the length it needs (which may be more
+   than space, as for snprintf). */
+static size_t SYS_DLOG_RenderText( const SYS_DLOG_RECORD *record, char *dst, size_t space )
+{
+    uint32_t arg[4] = {0U, 0U, 0U, 0U};
+    uint32_t i;
+    int length;
+
+    for (i = 0U; i < record->argCount; i++)
+    {
+        arg[i] = record->arg[i];
+    }
+
+    if (record->formatId < sysDlogObj.formatCount)
+    {
+        /* Unused trailing arguments are ignored by snprintf */
+        length = snprintf(dst, space, sysDlogObj.formats[record->formatId],
+                          arg[0], arg[1], arg[2], arg[3]);
+    }
+    else
+    {
+        length = snprintf(dst, space, "dlog: unknown format %u\r\n",
+                          (unsigned int)record->formatId);
+    }
+
+    return (length < 0) ? 0U : (size_t)length;
+}
+
+static size_t SYS_DLOG_RenderRaw( const SYS_DLOG_RECORD *record, uint8_t *dst )
+{
+    uint32_t i;
+    size_t length = 0U;
+
+    dst[length++] = SYS_DLOG_FRAME_SYNC;
+    dst[length++] = (uint8_t)(record->formatId & 0xFFU);
+    dst[length++] = (uint8_t)(record->formatId >> 8U);
+    dst[length++] = record->argCount;
+
+    for (i = 0U; i < record->argCount; i++)
+    {
+        dst[length++] = (uint8_t)(record->arg[i]);
+        dst[length++] = (uint8_t)(record->arg[i] >> 8U);
+        dst[length++] = (uint8_t)(record->arg[i] >> 16U);
+        dst[length++] = (uint8_t)(record->arg[i] >> 24U);
+    }
+
+    return length;
+}
+
+/* Appends one record to the output buffer, flushing it first if the record
+   does not fit behind what is already there. */
+static size_t SYS_DLOG_Append( const SYS_DLOG_RECORD *record, size_t fill )
+{
+    size_t length;
+
+    if (sysDlogObj.mode == SYS_DLOG_MODE_RAW)
+    {
+        if ((SYS_DLOG_BUFFER_SIZE - fill) < SYS_DLOG_FRAME_MAX_SIZE)
+        {
+            SYS_DLOG_Send(fill);
+            fill = 0U;
+        }
+
+        return fill + SYS_DLOG_RenderRaw(record, &sysDlogBuffer[fill]);
+    }
+
+    length = SYS_DLOG_RenderText(record, (char *)&sysDlogBuffer[fill], SYS_DLOG_BUFFER_SIZE - fill);
+
+    if ((length >= (SYS_DLOG_BUFFER_SIZE - fill)) && (fill != 0U))
+    {
+        SYS_DLOG_Send(fill);
+        fill = 0U;
+        length = SYS_DLOG_RenderText(record, (char *)sysDlogBuffer, SYS_DLOG_BUFFER_SIZE);
+    }
+
+    if (length >= (SYS_DLOG_BUFFER_SIZE - fill))
+    {
+        /* Truncated, drop the terminating NUL */
+        length = SYS_DLOG_BUFFER_SIZE - fill - 1U;
+    }
+
+    return fill + length;
+}
+
+static void SYS_DLOG_Task( void *pvParams )
+{
+    (void)pvParams;
+
+    for (;;)
+    {
+        SYS_DLOG_RING *ring;
+        size_t fill = 0U;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for (ring = sysDlogObj.rings; ring != NULL; ring = ring->next)
+        {
+            while (ring->tail != ring->head)
+            {
+                SYS_DLOG_RECORD record = ring->record[ring->tail & SYS_DLOG_RING_MASK];
+
+                SYS_DLOG_COMPILER_BARRIER();
+                ring->tail++;
+
+                fill = SYS_DLOG_Append(&record, fill);
+            }
+        }
+
+        if (fill != 0U)
+        {
+            SYS_DLOG_Send(fill);
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_DLOG_Initialize( const char * const *formats, uint16_t formatCount,
+                          SYS_DLOG_MODE mode, DMAC_CHANNEL channel )
+{
+    sysDlogObj.formats = formats;
+    sysDlogObj.formatCount = formatCount;
+    sysDlogObj.mode = mode;
+    sysDlogObj.channel = channel;
+    sysDlogObj.rings = NULL;
+
+    sysDlogObj.txDone = xSemaphoreCreateBinaryStatic(&sysDlogTxDoneObj);
+
+    DMAC_ChannelCallbackRegister(channel, SYS_DLOG_DmaHandler, 0);
+
+    sysDlogObj.task = xTaskCreateStatic(
+            SYS_DLOG_Task,
+            "Log Formatter",
+            SYS_DLOG_TASK_STACK_SIZE,
+            NULL,
+            SYS_DLOG_TASK_PRIORITY,
+            sysDlogTaskStack,
+            &sysDlogTaskTcb);
+}
+
+void SYS_DLOG_RingRegister( SYS_DLOG_RING *ring )
+{
+    ring->head = 0U;
+    ring->tail = 0U;
+    ring->dropped = 0U;
+
+    ring->next = sysDlogObj.rings;
+    sysDlogObj.rings = ring;
+}
+
+bool SYS_DLOG_Post( SYS_DLOG_RING *ring, uint16_t formatId, uint8_t argCount, ... )
+{
+    SYS_DLOG_RECORD *record;
+    va_list args;
+    uint32_t i;
+
+    if ((argCount > SYS_DLOG_MAX_ARGS) || ((ring->head - ring->tail) >= SYS_DLOG_RING_DEPTH))
+    {
+        ring->dropped++;
+        return false;
+    }
+
+    record = &ring->record[ring->head & SYS_DLOG_RING_MASK];
+    record->formatId = formatId;
+    record->argCount = argCount;
+
+    va_start(args, argCount);
+    for (i = 0U; i < argCount; i++)
+    {
+        record->arg[i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    SYS_DLOG_COMPILER_BARRIER();
+    ring->head++;
+
+    (void)xTaskNotifyGive(sysDlogObj.task);
+
+    return true;
+}
+
+uint32_t SYS_DLOG_DroppedCountGet( const SYS_DLOG_RING *ring )
+{
+    return ring->dropped;
+}
+
+size_t SYS_DLOG_Render( const SYS_DLOG_RECORD *record, SYS_DLOG_MODE mode, uint8_t *dst, size_t space )
+{
+    if (mode == SYS_DLOG_MODE_RAW)
+    {
+        return (space < SYS_DLOG_FRAME_MAX_SIZE) ? 0U : SYS_DLOG_RenderRaw(record, dst);
+    }
+
+    return SYS_DLOG_RenderText(record, (char *)dst, space);
+}
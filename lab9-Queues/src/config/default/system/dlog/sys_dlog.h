@@ -0,0 +1,214 @@
+/*******************************************************************************
+  System Deferred Log Service
+
+  File Name:
+    sys_dlog.h
+
+  Summary:
+    Binary log records posted by tasks, rendered later by a formatter task.
+
+  Description:
+    A task does not format its own messages.  It posts a format ID and up to
+    SYS_DLOG_MAX_ARGS 32-bit arguments into a ring it owns, which costs a few
+    stores and no lock, and carries on.  A low priority formatter task drains
+    every registered ring and either renders the records with the format
+    table and sends the text over UART6 by DMA, or ships the records raw so
+    that the host does the formatting.
+
+    Only the formatter task touches the UART buffer and the DMAC channel, so
+    producers need neither the UART mutex nor the stack for sprintf.
+
+    Arguments are copied by value when posted.  Formats may therefore only
+    use conversions that take one int sized argument (%d %u %x %c ...).  A
+    %s argument is a pointer and must still be valid when the formatter gets
+    to the record, in practice only string literals qualify.
+
+    Raw frame layout, all fields little endian:
+        0xA5, format ID (16 bit), argument count (8 bit), arguments (32 bit each)
+
+    tools/dlog_decode.py of the lab turns a captured raw stream back into
+    text with the format table of the application.
+*******************************************************************************/
+
+#ifndef SYS_DLOG_H
+#define SYS_DLOG_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "peripheral/dmac/plib_dmac.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Records per producer ring, must be a power of two. */
+#ifndef SYS_DLOG_RING_DEPTH
+    #define SYS_DLOG_RING_DEPTH         (8U)
+#endif
+
+/* Arguments carried by one record. */
+#ifndef SYS_DLOG_MAX_ARGS
+    #define SYS_DLOG_MAX_ARGS           (4U)
+#endif
+
+/* Text rendered per DMA transfer, multiple of the 16 byte cache line. */
+#ifndef SYS_DLOG_BUFFER_SIZE
+    #define SYS_DLOG_BUFFER_SIZE        (256U)
+#endif
+
+#ifndef SYS_DLOG_TASK_PRIORITY
+    #define SYS_DLOG_TASK_PRIORITY      (tskIDLE_PRIORITY)
+#endif
+
+#ifndef SYS_DLOG_TASK_STACK_SIZE
+    #define SYS_DLOG_TASK_STACK_SIZE    (configMINIMAL_STACK_SIZE * 2U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Output of the formatter task */
+typedef enum
+{
+    /* Render with the format table, send text */
+    SYS_DLOG_MODE_TEXT = 0,
+
+    /* Send the records as raw frames for decoding on the host */
+    SYS_DLOG_MODE_RAW
+
+} SYS_DLOG_MODE;
+
+typedef struct
+{
+    uint16_t formatId;
+    uint8_t argCount;
+    uint32_t arg[SYS_DLOG_MAX_ARGS];
+
+} SYS_DLOG_RECORD;
+
+/* One producer ring.  Allocated by the application, written by exactly one
+   task and read by the formatter task only. */
+typedef struct SYS_DLOG_RING
+{
+    SYS_DLOG_RECORD record[SYS_DLOG_RING_DEPTH];
+
+    /* Free running, a record index is (counter & (SYS_DLOG_RING_DEPTH - 1)) */
+    volatile uint32_t head;
+    volatile uint32_t tail;
+
+    volatile uint32_t dropped;
+
+    struct SYS_DLOG_RING *next;
+
+} SYS_DLOG_RING;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void SYS_DLOG_Initialize( const char * const *formats, uint16_t formatCount,
+                              SYS_DLOG_MODE mode, DMAC_CHANNEL channel )
+
+  Summary:
+    Creates the formatter task and takes over the UART6 DMAC channel.
+
+  Description:
+    formats is indexed by the format ID given to SYS_DLOG_Post and must stay
+    valid for the lifetime of the application.  The channel must already be
+    configured to start on the UART6 transmit interrupt.  Call once before
+    vTaskStartScheduler.
+*/
+void SYS_DLOG_Initialize( const char * const *formats, uint16_t formatCount,
+                          SYS_DLOG_MODE mode, DMAC_CHANNEL channel );
+
+// *****************************************************************************
+/* Function:
+    void SYS_DLOG_RingRegister( SYS_DLOG_RING *ring )
+
+  Summary:
+    Empties ring and adds it to the set drained by the formatter task.
+
+  Description:
+    Call before vTaskStartScheduler, one ring per producing task.
+*/
+void SYS_DLOG_RingRegister( SYS_DLOG_RING *ring );
+
+// *****************************************************************************
+/* Function:
+    bool SYS_DLOG_Post( SYS_DLOG_RING *ring, uint16_t formatId, uint8_t argCount, ... )
+
+  Summary:
+    Queues one record and wakes the formatter task, never blocks.
+
+  Description:
+    The variable arguments are argCount values of type uint32_t, cast them at
+    the call site.  Only the task owning ring may post to it.
+
+  Returns:
+    true if the record was queued, false if the ring was full or argCount
+    exceeds SYS_DLOG_MAX_ARGS (the record is counted as dropped).
+*/
+bool SYS_DLOG_Post( SYS_DLOG_RING *ring, uint16_t formatId, uint8_t argCount, ... );
+
+// *****************************************************************************
+/* Function:
+    uint32_t SYS_DLOG_DroppedCountGet( const SYS_DLOG_RING *ring )
+
+  Summary:
+    Number of records rejected by SYS_DLOG_Post on ring.
+*/
+uint32_t SYS_DLOG_DroppedCountGet( const SYS_DLOG_RING *ring );
+
+// *****************************************************************************
+/* Function:
+    size_t SYS_DLOG_Render( const SYS_DLOG_RECORD *record, SYS_DLOG_MODE mode,
+                            uint8_t *dst, size_t space )
+
+  Summary:
+    Renders record into dst the way the formatter task would in mode.
+
+  Description:
+    Lets the application measure what each mode costs the formatter task,
+    in cycles and in stack, without going through the UART.  Call after
+    SYS_DLOG_Initialize.
+
+  Returns:
+    Text: the length snprintf needed, which may be more than space.
+    Raw: the frame length, or 0 if space is below the largest frame.
+*/
+size_t SYS_DLOG_Render( const SYS_DLOG_RECORD *record, SYS_DLOG_MODE mode,
+                        uint8_t *dst, size_t space );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_DLOG_H
@@ -0,0 +1,119 @@
+/*******************************************************************************
+  System Zero-Copy Queue Service
+
+  File Name:
+    sys_zqueue.c
+
+  Summary:
+    Queue that passes pool blocks by pointer instead of copying items.
+
+  Description:
+    Both pointer queues are as long as the pool, and a block is always in at
+    most one of them, so a send to either can never find it full.  The
+    configASSERTs catch a pointer that is not a block of this pool.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "sys_zqueue.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool SYS_ZQUEUE_IsBlock( const SYS_ZQUEUE *zq, const void *block )
+{
+    size_t offset = (size_t)((const uint8_t *)block - zq->pool);
+
+    return ((const uint8_t *)block >= zq->pool) &&
+           (offset < (zq->blockSize * zq->blockCount)) &&
+           ((offset % zq->blockSize) == 0U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+bool SYS_ZQUEUE_Create( SYS_ZQUEUE *zq, uint8_t *pool, size_t itemSize, uint32_t blockCount )
+{
+    uint32_t i;
+    void *block;
+
+    if ((blockCount == 0U) || (blockCount > SYS_ZQUEUE_MAX_BLOCKS))
+    {
+        return false;
+    }
+
+    zq->pool = pool;
+    zq->blockSize = SYS_ZQUEUE_BLOCK_SIZE(itemSize);
+    zq->blockCount = blockCount;
+
+    zq->freeQueue = xQueueCreateStatic(blockCount, sizeof(void *),
+                                       (uint8_t *)zq->freeStorage, &zq->freeQueueObj);
+    zq->sendQueue = xQueueCreateStatic(blockCount, sizeof(void *),
+                                       (uint8_t *)zq->sendStorage, &zq->sendQueueObj);
+
+    for (i = 0U; i < blockCount; i++)
+    {
+        block = &pool[i * zq->blockSize];
+        (void)xQueueSend(zq->freeQueue, &block, 0);
+    }
+
+    return true;
+}
+
+void *SYS_ZQUEUE_Alloc( SYS_ZQUEUE *zq, TickType_t xTicksToWait )
+{
+    void *block = NULL;
+
+    if (xQueueReceive(zq->freeQueue, &block, xTicksToWait) != pdTRUE)
+    {
+        return NULL;
+    }
+
+    return block;
+}
+
+void SYS_ZQUEUE_Send( SYS_ZQUEUE *zq, void *block )
+{
+    BaseType_t result;
+
+    configASSERT(SYS_ZQUEUE_IsBlock(zq, block));
+
+    result = xQueueSend(zq->sendQueue, &block, 0);
+    configASSERT(result == pdTRUE);
+    (void)result;
+}
+
+void *SYS_ZQUEUE_Receive( SYS_ZQUEUE *zq, TickType_t xTicksToWait )
+{
+    void *block = NULL;
+
+    if (xQueueReceive(zq->sendQueue, &block, xTicksToWait) != pdTRUE)
+    {
+        return NULL;
+    }
+
+    return block;
+}
+
+void SYS_ZQUEUE_Release( SYS_ZQUEUE *zq, void *block )
+{
+    BaseType_t result;
+
+    configASSERT(SYS_ZQUEUE_IsBlock(zq, block));
+
+    result = xQueueSend(zq->freeQueue, &block, 0);
+    configASSERT(result == pdTRUE);
+    (void)result;
+}
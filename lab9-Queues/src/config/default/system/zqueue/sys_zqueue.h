@@ -0,0 +1,163 @@
+/*******************************************************************************
+  System Zero-Copy Queue Service
+
+  File Name:
+    sys_zqueue.h
+
+  Summary:
+    Queue that passes pool blocks by pointer instead of copying items.
+
+  Description:
+    A queue created with xQueueCreate copies every item into its storage on
+    send and out of it on receive, both inside a critical section.  For large
+    items (lab9 sends a 208 byte TaskData_t) that is most of the cost.
+
+    A zero-copy queue owns a pool of fixed size blocks.  The producer takes
+    a free block with SYS_ZQUEUE_Alloc, fills it in place and sends it, the
+    consumer receives the same block and gives it back with
+    SYS_ZQUEUE_Release when done.  Only the 4 byte pointer goes through the
+    kernel: free blocks wait in one FreeRTOS queue of pointers, sent blocks
+    in another.  Each has room for every block, so Send and Release never
+    block; Alloc blocks while the pool is empty, which is the back pressure a
+    full copying queue would give.
+
+    A block belongs to exactly one side at a time.  The producer must not
+    touch it after Send, the consumer not after Release.
+*******************************************************************************/
+
+#ifndef SYS_ZQUEUE_H
+#define SYS_ZQUEUE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Blocks a queue can own at most. */
+#ifndef SYS_ZQUEUE_MAX_BLOCKS
+    #define SYS_ZQUEUE_MAX_BLOCKS       (8U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Size of one block holding size bytes, blocks start on 8 bytes. */
+#define SYS_ZQUEUE_BLOCK_SIZE(size)     ((((size) + 8U) - 1U) & ~(8U - 1U))
+
+/* Declares the pool of a queue, e.g.
+   static uint8_t SYS_ZQUEUE_POOL(xPool, sizeof(TaskData_t), 5); */
+#define SYS_ZQUEUE_POOL(name, size, count) \
+    __attribute__ ((aligned (8))) name[SYS_ZQUEUE_BLOCK_SIZE(size) * (count)]
+
+/* One queue.  Allocated by the application, set up by SYS_ZQUEUE_Create. */
+typedef struct
+{
+    QueueHandle_t freeQueue;
+    QueueHandle_t sendQueue;
+
+    StaticQueue_t freeQueueObj;
+    StaticQueue_t sendQueueObj;
+
+    void *freeStorage[SYS_ZQUEUE_MAX_BLOCKS];
+    void *sendStorage[SYS_ZQUEUE_MAX_BLOCKS];
+
+    uint8_t *pool;
+    size_t blockSize;
+    uint32_t blockCount;
+
+} SYS_ZQUEUE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool SYS_ZQUEUE_Create( SYS_ZQUEUE *zq, uint8_t *pool, size_t itemSize,
+                            uint32_t blockCount )
+
+  Summary:
+    Sets up zq with blockCount free blocks of itemSize bytes from pool.
+
+  Description:
+    pool is declared with SYS_ZQUEUE_POOL using the same itemSize and
+    blockCount.  Returns false if blockCount is 0 or above
+    SYS_ZQUEUE_MAX_BLOCKS.
+*/
+bool SYS_ZQUEUE_Create( SYS_ZQUEUE *zq, uint8_t *pool, size_t itemSize, uint32_t blockCount );
+
+// *****************************************************************************
+/* Function:
+    void *SYS_ZQUEUE_Alloc( SYS_ZQUEUE *zq, TickType_t xTicksToWait )
+
+  Summary:
+    Takes a free block, waiting up to xTicksToWait for one.
+
+  Description:
+    Returns NULL on timeout.  The content of the block is what its previous
+    user left in it.
+*/
+void *SYS_ZQUEUE_Alloc( SYS_ZQUEUE *zq, TickType_t xTicksToWait );
+
+// *****************************************************************************
+/* Function:
+    void SYS_ZQUEUE_Send( SYS_ZQUEUE *zq, void *block )
+
+  Summary:
+    Passes a filled block to the consumer, never blocks.
+*/
+void SYS_ZQUEUE_Send( SYS_ZQUEUE *zq, void *block );
+
+// *****************************************************************************
+/* Function:
+    void *SYS_ZQUEUE_Receive( SYS_ZQUEUE *zq, TickType_t xTicksToWait )
+
+  Summary:
+    Oldest sent block, NULL if none arrived within xTicksToWait.
+*/
+void *SYS_ZQUEUE_Receive( SYS_ZQUEUE *zq, TickType_t xTicksToWait );
+
+// *****************************************************************************
+/* Function:
+    void SYS_ZQUEUE_Release( SYS_ZQUEUE *zq, void *block )
+
+  Summary:
+    Returns a received block to the pool, never blocks.
+*/
+void SYS_ZQUEUE_Release( SYS_ZQUEUE *zq, void *block );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+// DOM-IGNORE-END
+
+#endif // SYS_ZQUEUE_H
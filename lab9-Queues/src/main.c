@@ -16,10 +16,10 @@
 		Static Task 
  *		UART TX
  *		FreeRTOS
- *		Mutex
- *		Binary Semaphore
+ *		Deferred log (format ID + arguments, rendered by a formatter task)
  *		Custom struct
  *		Static Queue
+ *		Zero-copy queue (pool blocks passed by pointer)
 
   Summary:
     Queues are the primary mechanism for inter-task communications. They can be used
@@ -49,9 +49,9 @@ to send messages between tasks, and between interrupts and tasks.
 #include <stdint.h>
 #include <string.h>
 #include "task.h"
-#include "device_cache.h"
-#include "semphr.h"
 #include "queue.h"
+#include "system/dlog/sys_dlog.h"
+#include "system/zqueue/sys_zqueue.h"
 
 //declare variables for static tasks
 static StackType_t xTaskSendTcbBuffer[configMINIMAL_STACK_SIZE];
@@ -71,7 +71,7 @@ typedef struct TaskData_t{
 	uint8_t ID;
 } TaskData_t;
 
-//declare xData that is passed to Task Send at creation and then is updated and sent to Task Receive via the queue
+//declare xData that is passed to Task Send at creation, task Send fills a queue block from it and sends the block to Task Receive
 static TaskData_t xData ={
 	.main_msg = "main pass parameter to Sending task \r\n",
 	.task_msg = "Sending task sent to Receive task \r\n",
@@ -79,24 +79,45 @@ static TaskData_t xData ={
 	.ID = 0
 };
 
-//declare the Queue
-static QueueHandle_t xQueue;
+//declare the zero-copy queue, a TaskData_t travels as a pointer to a pool block instead of being copied twice
+static SYS_ZQUEUE xZQueue;
 
-//declare buffer of uart for displaying message in com port via dma
-static uint8_t __attribute__ ((aligned (16)))u6TxBuffer[150] = {0};
+//declare the IDs of log messages, tasks post an ID plus arguments and the formatter task renders them
+enum {
+	LOG_HELLO_SEND = 0,
+	LOG_HELLO_RECEIVE,
+	LOG_RECEIVED,
+	LOG_BENCH,
+	LOG_BURST,
+	LOG_COST_RAW,
+	LOG_COST_TEXT
+};
 
-//delcare mutex and binary semaphore to protect uart buffer and uart transfer event
-static SemaphoreHandle_t xMutex;
-static SemaphoreHandle_t xBinarySema;
+//declare the format table, indexed by the IDs above - only int sized conversions
+static const char * const xLogFormats[] = {
+	[LOG_HELLO_SEND] = "hello it is task Send\r\n",
+	[LOG_HELLO_RECEIVE] = "alo task Receive is running ...\r\n",
+	[LOG_RECEIVED] = "Sending task sent to Receiving task  in %u time and free of %u words \r\n",
+	[LOG_BENCH] = "send+receive of %u bytes: queue copy %u cycles, zero-copy %u cycles \r\n",
+	[LOG_BURST] = "burst of %u words: single %u cycles/item, multiple %u cycles/item \r\n",
+	[LOG_COST_RAW] = "dlog raw: post %u cycles, render %u cycles, render stack %u words \r\n",
+	[LOG_COST_TEXT] = "dlog text: post %u cycles, render %u cycles, render stack %u words \r\n"
+};
 
-//declare an interrupt for dmac transfer event
-static void U6D6Handler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle){
-	if (event == DMAC_TRANSFER_EVENT_COMPLETE){
-		BaseType_t xHighPriorityTaskWoken = pdFALSE;
-		xSemaphoreGiveFromISR(xBinarySema, &xHighPriorityTaskWoken);
-		portEND_SWITCHING_ISR(xHighPriorityTaskWoken);
-	}
-}
+//declare one log ring per task, no mutex is needed since each ring has a single writer
+static SYS_DLOG_RING xSendLogRing;
+static SYS_DLOG_RING xReceiveLogRing;
+static SYS_DLOG_RING xProbeLogRing;
+
+//declare the probe task measuring what a log record costs in each mode of the formatter task
+//its stack is as large as the one of the formatter task and starts unused, so its high-water mark is the stack of rendering
+#define DLOG_PROBE_ROUNDS 32
+static StackType_t xDlogProbeStack[SYS_DLOG_TASK_STACK_SIZE];
+static StaticTask_t xDlogProbeBuffer;
+static void prvDlogProbeFunction(void * pvParams);
+//the probe posts its timed records here, the ring is not registered so the formatter task never sends them
+static SYS_DLOG_RING xDlogBenchRing;
+static uint8_t xDlogProbeOutput[SYS_DLOG_BUFFER_SIZE];
 
 static void Debug_msg(char * msg){
 	while (*msg){
@@ -110,11 +131,24 @@ static void Debug_msg(char * msg){
 #define QUEUE_LENGTH 5
 #define ITEM_SIZE sizeof(TaskData_t)
 
-//declare memory for the queue
-static uint8_t xQueueStorage[QUEUE_LENGTH * ITEM_SIZE];
+//declare the pool of the zero-copy queue, one block per queue slot
+static uint8_t SYS_ZQUEUE_POOL(xZQueuePool, ITEM_SIZE, QUEUE_LENGTH);
+
+//declare a copying queue and a zero-copy queue of one item, only for the benchmark of task Send
+#define BENCH_ROUNDS 100
+static QueueHandle_t xBenchQueue;
+static StaticQueue_t xBenchQueueObj;
+static uint8_t xBenchQueueStorage[ITEM_SIZE];
+static TaskData_t xBenchItem;
+static SYS_ZQUEUE xBenchZQueue;
+static uint8_t SYS_ZQUEUE_POOL(xBenchZQueuePool, ITEM_SIZE, 1);
 
-//declare static queue object
-static StaticQueue_t xQueueObj;
+//declare a queue of words for the burst benchmark, single item calls vs one call per burst
+#define BURST_MAX 8
+static QueueHandle_t xBurstQueue;
+static StaticQueue_t xBurstQueueObj;
+static uint8_t xBurstQueueStorage[BURST_MAX * sizeof(uint32_t)];
+static uint32_t xBurstWords[BURST_MAX];
 
 
 int main(void){
@@ -123,11 +157,15 @@ int main(void){
 	//display welcome message
 	Debug_msg("lab9-FreeRTOS-inter-task communication\r\n");
 	
-	//initialize DMAC for showing the result via uart+dmac
-	DMAC_ChannelCallbackRegister(
-		DMAC_CHANNEL_6,
-		U6D6Handler,
-		0);
+	//hand uart+dmac over to the log formatter task, tasks only post IDs and arguments
+	SYS_DLOG_Initialize(
+		xLogFormats,
+		sizeof(xLogFormats) / sizeof(xLogFormats[0]),
+		SYS_DLOG_MODE_TEXT,
+		DMAC_CHANNEL_6);
+	SYS_DLOG_RingRegister(&xSendLogRing);
+	SYS_DLOG_RingRegister(&xReceiveLogRing);
+	SYS_DLOG_RingRegister(&xProbeLogRing);
 	
 	//create task Send -  static - pass a struct at creation
 	TaskHandle_t xTaskSendResult = xTaskCreateStatic(
@@ -160,24 +198,49 @@ int main(void){
 	}
 	
 	
-	//create xMutex for protecting uart buffer
-	xMutex = xSemaphoreCreateMutex();
-	
-	//create xBinarySem for protecting uart transfer
-	xBinarySema = xSemaphoreCreateBinary();
-	
-	//create xQueue for inter-task communication
-	xQueue = xQueueCreateStatic(
-		QUEUE_LENGTH,
+	//create xZQueue for inter-task communication
+	if (SYS_ZQUEUE_Create(
+		&xZQueue,
+		xZQueuePool,
 		ITEM_SIZE,
-		xQueueStorage,
-		&(xQueueObj));
-	//handle the result of the creation of the Queue
-	if (xQueue == NULL){
+		QUEUE_LENGTH) == false){
 		Debug_msg("cannot create the Queue\r\n");
 		return (EXIT_FAILURE);
 	}
 	
+	//create the queues of the benchmark
+	xBenchQueue = xQueueCreateStatic(
+		1,
+		ITEM_SIZE,
+		xBenchQueueStorage,
+		&(xBenchQueueObj));
+	if ((xBenchQueue == NULL) || (SYS_ZQUEUE_Create(&xBenchZQueue, xBenchZQueuePool, ITEM_SIZE, 1) == false)){
+		Debug_msg("cannot create the benchmark queues\r\n");
+		return (EXIT_FAILURE);
+	}
+	xBurstQueue = xQueueCreateStatic(
+		BURST_MAX,
+		sizeof(uint32_t),
+		xBurstQueueStorage,
+		&(xBurstQueueObj));
+	if (xBurstQueue == NULL){
+		Debug_msg("cannot create the burst queue\r\n");
+		return (EXIT_FAILURE);
+	}
+	
+	//create the probe of the log cost - static - it deletes itself when done
+	if (xTaskCreateStatic(
+		prvDlogProbeFunction,
+		"Log Probe",
+		SYS_DLOG_TASK_STACK_SIZE,
+		NULL,
+		tskIDLE_PRIORITY,
+		xDlogProbeStack,
+		&(xDlogProbeBuffer)) == NULL){
+		Debug_msg("cannot create task Log Probe\r\n");
+		return (EXIT_FAILURE);
+	}
+	
 	vTaskStartScheduler();
 	
 	for (;;){
@@ -187,34 +250,154 @@ int main(void){
 	return (EXIT_FAILURE);
 }
 
+//measure the core timer for BENCH_ROUNDS send+receive of one TaskData_t, copied vs passed by pointer,
+//then for bursts of words sent and received one by one vs in one call
+static void prvBenchmark(const TaskData_t * item){
+	uint32_t start;
+	uint32_t copyTicks;
+	uint32_t zeroTicks;
+	void * block;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+		xQueueSend(xBenchQueue, item, 0);
+		xQueueReceive(xBenchQueue, &xBenchItem, 0);
+	}
+	copyTicks = _CP0_GET_COUNT() - start;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+		block = SYS_ZQUEUE_Alloc(&xBenchZQueue, 0);
+		SYS_ZQUEUE_Send(&xBenchZQueue, block);
+		block = SYS_ZQUEUE_Receive(&xBenchZQueue, 0);
+		SYS_ZQUEUE_Release(&xBenchZQueue, block);
+	}
+	zeroTicks = _CP0_GET_COUNT() - start;
+	
+	//the core timer counts every second cpu cycle
+	SYS_DLOG_Post(
+		&xSendLogRing,
+		LOG_BENCH,
+		3,
+		(uint32_t)ITEM_SIZE,
+		(copyTicks * 2) / BENCH_ROUNDS,
+		(zeroTicks * 2) / BENCH_ROUNDS);
+	
+	//repeat with bursts of 1, 2, 4 and 8 words through xBurstQueue
+	for (uint32_t burst = 1; burst <= BURST_MAX; burst *= 2){
+		start = _CP0_GET_COUNT();
+		for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+			for (uint32_t i = 0; i < burst; i++){
+				xQueueSend(xBurstQueue, &xBurstWords[i], 0);
+			}
+			for (uint32_t i = 0; i < burst; i++){
+				xQueueReceive(xBurstQueue, &xBurstWords[i], 0);
+			}
+		}
+		copyTicks = _CP0_GET_COUNT() - start;
+		
+		start = _CP0_GET_COUNT();
+		for (uint8_t round = 0; round < BENCH_ROUNDS; round++){
+			uxQueueSendMultiple(xBurstQueue, xBurstWords, burst, 0);
+			uxQueueReceiveMultiple(xBurstQueue, xBurstWords, burst, burst, 0);
+		}
+		zeroTicks = _CP0_GET_COUNT() - start;
+		
+		SYS_DLOG_Post(
+			&xSendLogRing,
+			LOG_BURST,
+			3,
+			burst,
+			(copyTicks * 2) / (BENCH_ROUNDS * burst),
+			(zeroTicks * 2) / (BENCH_ROUNDS * burst));
+	}
+}
+
+//measure the cycles of SYS_DLOG_Post, then the cycles and the stack of rendering one record, raw first and text second:
+//the high-water mark only grows, and the text mode needs snprintf so it is the deeper one
+static void prvDlogProbeFunction(void * pvParams){
+	(void)pvParams;
+	SYS_DLOG_RECORD record = {
+		.formatId = LOG_BENCH,
+		.argCount = 3,
+		.arg = {(uint32_t)ITEM_SIZE, 1234, 567}
+	};
+	uint32_t start;
+	uint32_t postTicks;
+	uint32_t renderTicks;
+	UBaseType_t unused = uxTaskGetStackHighWaterMark(NULL);
+	UBaseType_t left;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < DLOG_PROBE_ROUNDS; round++){
+		SYS_DLOG_Post(&xDlogBenchRing, LOG_BENCH, 3, record.arg[0], record.arg[1], record.arg[2]);
+		//nobody drains the bench ring, drop the record so that the next post is not rejected
+		xDlogBenchRing.tail = xDlogBenchRing.head;
+	}
+	postTicks = _CP0_GET_COUNT() - start;
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < DLOG_PROBE_ROUNDS; round++){
+		SYS_DLOG_Render(&record, SYS_DLOG_MODE_RAW, xDlogProbeOutput, sizeof(xDlogProbeOutput));
+	}
+	renderTicks = _CP0_GET_COUNT() - start;
+	left = uxTaskGetStackHighWaterMark(NULL);
+	
+	//the core timer counts every second cpu cycle
+	SYS_DLOG_Post(
+		&xProbeLogRing,
+		LOG_COST_RAW,
+		3,
+		(postTicks * 2) / DLOG_PROBE_ROUNDS,
+		(renderTicks * 2) / DLOG_PROBE_ROUNDS,
+		(uint32_t)(unused - left));
+	
+	start = _CP0_GET_COUNT();
+	for (uint8_t round = 0; round < DLOG_PROBE_ROUNDS; round++){
+		SYS_DLOG_Render(&record, SYS_DLOG_MODE_TEXT, xDlogProbeOutput, sizeof(xDlogProbeOutput));
+	}
+	renderTicks = _CP0_GET_COUNT() - start;
+	left = uxTaskGetStackHighWaterMark(NULL);
+	
+	SYS_DLOG_Post(
+		&xProbeLogRing,
+		LOG_COST_TEXT,
+		3,
+		(postTicks * 2) / DLOG_PROBE_ROUNDS,
+		(renderTicks * 2) / DLOG_PROBE_ROUNDS,
+		(uint32_t)(unused - left));
+	
+	vTaskDelete(NULL);
+}
+
 static void prvTaskSendFunction (void * pvParams){
 	TaskData_t * localSend = (TaskData_t *) pvParams;
+	TaskData_t * block;
 	
-	BaseType_t xQueueSendResult ;
-	//show welcome message from Sending task-using mutex to protect uart transfer register
-	if (xSemaphoreTake(xMutex, portMAX_DELAY) ==pdTRUE){
-		Debug_msg("hello it is task Send\r\n");
-	}
-	xSemaphoreGive(xMutex);
+	//show welcome message from Sending task
+	SYS_DLOG_Post(&xSendLogRing, LOG_HELLO_SEND, 0);
+	
+	prvBenchmark(localSend);
 	
 	for (uint8_t send=0; send < 6 ; send++){
-		//get stack water mark and update xData.StackFree and task msg
-		BaseType_t FreeOfStack = uxTaskGetStackHighWaterMark(NULL);
-		localSend->StackFree = (unsigned int)FreeOfStack;
-		strncpy(localSend->task_msg, "Sending task sent to Receiving task ", sizeof(localSend->task_msg));
-		localSend->ID = send+1;
-
-		//send xData to xQueue
-		xQueueSendResult = xQueueSend(
-			xQueue,
-			localSend,
-			pdMS_TO_TICKS(20));
-		//handle the result of the sending
-		if (xQueueSendResult == pdFALSE){
+		//take a free block of the queue, waiting while task Receive holds all of them
+		block = SYS_ZQUEUE_Alloc(&xZQueue, pdMS_TO_TICKS(20));
+		//handle the result of the allocation
+		if (block == NULL){
 			Debug_msg("cannot send data to the Queue\r\n");
 			exit(EXIT_FAILURE);
 
 		}
+		
+		//fill the block in place: stack water mark, messages and ID
+		BaseType_t FreeOfStack = uxTaskGetStackHighWaterMark(NULL);
+		block->StackFree = (unsigned int)FreeOfStack;
+		strncpy(block->main_msg, localSend->main_msg, sizeof(block->main_msg));
+		strncpy(block->task_msg, "Sending task sent to Receiving task ", sizeof(block->task_msg));
+		block->ID = send+1;
+
+		//send the block to xZQueue, only its address is queued
+		SYS_ZQUEUE_Send(&xZQueue, block);
 
 		//task delay
 		vTaskDelay(pdMS_TO_TICKS(1000));
@@ -227,44 +410,29 @@ static void prvTaskReceiveFunction(void * pvParams){
 	//stop warning for unused parameters
 	(void )pvParams;
 	
-	//declare the data structure for receiving from Queue
-	TaskData_t localReceive;
+	//declare the block received from the Queue, it stays in the pool
+	TaskData_t * localReceive;
 	
 	//show welcome message from Receiving task
-	if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-		Debug_msg("alo task Receive is running ...\r\n");
-	}
-	xSemaphoreGive(xMutex);
+	SYS_DLOG_Post(&xReceiveLogRing, LOG_HELLO_RECEIVE, 0);
 	
 	for (uint8_t rec = 0; rec < 6 ; rec++){
-		//read xData from xQueue
-		if (xQueueReceive(
-			xQueue,
-			&localReceive,
-			portMAX_DELAY) ==pdFALSE){
+		//read the block from xZQueue
+		localReceive = SYS_ZQUEUE_Receive(&xZQueue, portMAX_DELAY);
+		if (localReceive == NULL){
 				Debug_msg("cannot receive from queue...\r\n");
 				exit(EXIT_FAILURE);
 		}
 		
-		if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE){
-			//format string
-			sprintf((char *)u6TxBuffer, "%s in %d time and free of %d words \r\n", localReceive.task_msg, localReceive.ID, localReceive.StackFree);
-			//flush from cache to RAM
-			DCACHE_CLEAN_BY_ADDR(
-				(uint32_t) u6TxBuffer,
-				strlen((const char *)u6TxBuffer));
-			//dmac transfer
-			DMAC_ChannelTransfer(
-				DMAC_CHANNEL_6,
-				(const void *)u6TxBuffer,
-				strlen((const char *)u6TxBuffer),
-				(const void *)&U6TXREG, 1, 1);
-			
-			//waiting for the taking binary semaphore from ISR
-			xSemaphoreTake(xBinarySema, portMAX_DELAY);
-			//give the mutex
-			xSemaphoreGive(xMutex);
-		}
+		//post the result, the text of task_msg is part of the LOG_RECEIVED format
+		SYS_DLOG_Post(
+			&xReceiveLogRing,
+			LOG_RECEIVED,
+			2,
+			(uint32_t)localReceive->ID,
+			(uint32_t)localReceive->StackFree);
+		//give the block back to the pool, it must not be used after this
+		SYS_ZQUEUE_Release(&xZQueue, localReceive);
 		//task delay
 		vTaskDelay(pdMS_TO_TICKS(1000));
 	}
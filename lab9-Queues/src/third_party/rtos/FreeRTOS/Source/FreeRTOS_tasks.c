@@ -271,10 +271,42 @@
         pxTemp = pxDelayedTaskList;                                               \
         pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
         pxOverflowDelayedTaskList = pxTemp;                                       \
+        taskSWITCH_DELAYED_TASK_HEAPS();                                          \
         xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 );                 \
         prvResetNextTaskUnblockTime();                                            \
     } while( 0 )
 
+#if ( configUSE_DELAYED_TASK_HEAP == 0 )
+
+/* The delayed task lists are kept in wake time order. */
+    #define taskINSERT_DELAYED_TASK( pxList, pxHeap, pxTCB )    vListInsert( ( pxList ), &( ( pxTCB )->xStateListItem ) )
+
+    #define taskSWITCH_DELAYED_TASK_HEAPS()
+
+#else /* configUSE_DELAYED_TASK_HEAP */
+
+/* The delayed task lists are unordered, the paired heap orders the tasks by
+ * wake time. */
+    #define taskINSERT_DELAYED_TASK( pxList, pxHeap, pxTCB )                \
+    do {                                                                    \
+        listINSERT_END( ( pxList ), &( ( pxTCB )->xStateListItem ) );       \
+        prvDelayedHeapInsert( ( pxHeap ), ( pxTCB ) );                      \
+    } while( 0 )
+
+/* Each heap stays paired with its list when the lists are switched. */
+    #define taskSWITCH_DELAYED_TASK_HEAPS()                           \
+    do {                                                              \
+        DelayedTaskHeap_t * pxTempHeap;                               \
+                                                                      \
+        pxTempHeap = pxDelayedTaskHeap;                               \
+        pxDelayedTaskHeap = pxOverflowDelayedTaskHeap;                \
+        pxOverflowDelayedTaskHeap = pxTempHeap;                       \
+    } while( 0 )
+
+    #define taskDELAYED_HEAP_WAKE_TIME( pxTCB )    listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) )
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -397,6 +429,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         BaseType_t xPreemptionDisable; /**< Used to prevent the task from being preempted. */
     #endif
 
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        UBaseType_t uxDelayedHeapIndex; /**< One more than the position of the task's entry in a delayed task heap, 0 if it has no entry. */
+    #endif
+
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxEndOfStack; /**< Points to the highest valid address for the stack. */
     #endif
@@ -479,6 +515,30 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Po
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/* Each delayed task list is paired with a binary min-heap of its tasks ordered
+ * by wake time, so blocking costs O(log n) and the next task to wake is the
+ * root.  The tasks stay in the list as well, so the code that takes a task out
+ * of the Blocked state through its state list item is unchanged.  Such a task
+ * leaves its heap entry behind.  The entry is known to be stale because the
+ * task is no longer in the paired list, and is dropped when it reaches the
+ * root, reused when the task blocks again, or removed when the task is
+ * deleted.  A task therefore has at most one entry in either heap. */
+    typedef struct xDELAYED_TASK_HEAP
+    {
+        List_t * pxList;                                  /**< The delayed task list the heap is paired with. */
+        UBaseType_t uxLength;                             /**< Number of entries, stale ones included. */
+        TCB_t * pxTCBs[ configDELAYED_TASK_HEAP_LENGTH ]; /**< Entry i wakes no later than entries 2i+1 and 2i+2. */
+    } DelayedTaskHeap_t;
+
+    PRIVILEGED_DATA static DelayedTaskHeap_t xDelayedTaskHeap1;          /**< Paired with xDelayedTaskList1. */
+    PRIVILEGED_DATA static DelayedTaskHeap_t xDelayedTaskHeap2;          /**< Paired with xDelayedTaskList2. */
+    PRIVILEGED_DATA static DelayedTaskHeap_t * pxDelayedTaskHeap;         /**< Paired with pxDelayedTaskList. */
+    PRIVILEGED_DATA static DelayedTaskHeap_t * pxOverflowDelayedTaskHeap; /**< Paired with pxOverflowDelayedTaskList. */
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /**< Tasks that have been deleted - but their memory not yet freed. */
@@ -698,6 +758,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/*
+ * Move the entry at uxIndex of pxHeap up or down until the heap is in wake
+ * time order again.
+ */
+    static void prvDelayedHeapSift( DelayedTaskHeap_t * pxHeap,
+                                    UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give pxTCB, which has just been placed in the list paired with pxHeap, its
+ * entry in pxHeap.  An entry the task still has from an earlier block is
+ * reused.
+ */
+    static void prvDelayedHeapInsert( DelayedTaskHeap_t * pxHeap,
+                                      TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the entry of pxTCB from whichever heap holds it, if it has one.
+ */
+    static void prvDelayedHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Drop stale entries from the root of pxHeap and return the task that wakes
+ * first, or NULL if the paired list is empty.
+ */
+    static TCB_t * prvDelayedHeapPeek( DelayedTaskHeap_t * pxHeap ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -2235,6 +2325,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+            {
+                /* The heap must not refer to the TCB once it is freed. */
+                prvDelayedHeapRemove( pxTCB );
+            }
+            #endif
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -4766,6 +4863,13 @@ BaseType_t xTaskIncrementTick( void )
         {
             for( ; ; )
             {
+                #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+                {
+                    /* Leaves the task that wakes first at the root. */
+                    pxTCB = prvDelayedHeapPeek( pxDelayedTaskHeap );
+                }
+                #endif
+
                 if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
                 {
                     /* The delayed list is empty.  Set xNextTaskUnblockTime
@@ -4782,10 +4886,14 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-                    /* coverity[misra_c_2012_rule_11_5_violation] */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+                    #if ( configUSE_DELAYED_TASK_HEAP == 0 )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+                    }
+                    #endif
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -4806,6 +4914,12 @@ BaseType_t xTaskIncrementTick( void )
                     /* It is time to remove the item from the Blocked state. */
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
+                    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+                    {
+                        prvDelayedHeapRemove( pxTCB );
+                    }
+                    #endif
+
                     /* Is the task waiting on an event also?  If so remove
                      * it from the event list. */
                     if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
@@ -5556,6 +5670,87 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_DIRECT_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+         * called from a critical section within an ISR.  Event groups that are
+         * set directly from interrupts only access their list of waiting tasks
+         * from critical sections, so exclusive access is guaranteed here. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem );
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The item value survives
+             * the move, the task reads it once it runs. */
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+            {
+                xReturn = pdTRUE;
+
+                /* Mark that a yield is pending in case the user is not using the
+                 * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+                xYieldPendings[ 0 ] = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_ISR */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
@@ -6093,6 +6288,17 @@ static void prvInitialiseTaskLists( void )
      * using list2. */
     pxDelayedTaskList = &xDelayedTaskList1;
     pxOverflowDelayedTaskList = &xDelayedTaskList2;
+
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    {
+        xDelayedTaskHeap1.pxList = &xDelayedTaskList1;
+        xDelayedTaskHeap1.uxLength = ( UBaseType_t ) 0U;
+        xDelayedTaskHeap2.pxList = &xDelayedTaskList2;
+        xDelayedTaskHeap2.uxLength = ( UBaseType_t ) 0U;
+        pxDelayedTaskHeap = &xDelayedTaskHeap1;
+        pxOverflowDelayedTaskHeap = &xDelayedTaskHeap2;
+    }
+    #endif /* configUSE_DELAYED_TASK_HEAP */
 }
 /*-----------------------------------------------------------*/
 
@@ -6514,6 +6720,13 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvResetNextTaskUnblockTime( void )
 {
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    {
+        /* Leaves the task that wakes first at the root. */
+        ( void ) prvDelayedHeapPeek( pxDelayedTaskHeap );
+    }
+    #endif
+
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
     {
         /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
@@ -6528,11 +6741,168 @@ static void prvResetNextTaskUnblockTime( void )
          * the item at the head of the delayed list.  This is the time at
          * which the task at the head of the delayed list should be removed
          * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        #if ( configUSE_DELAYED_TASK_HEAP == 0 )
+        {
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+        #else
+        {
+            xNextTaskUnblockTime = taskDELAYED_HEAP_WAKE_TIME( pxDelayedTaskHeap->pxTCBs[ 0 ] );
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    static void prvDelayedHeapSift( DelayedTaskHeap_t * pxHeap,
+                                    UBaseType_t uxIndex )
+    {
+        TCB_t * const pxTCB = pxHeap->pxTCBs[ uxIndex ];
+        const TickType_t xTimeToWake = taskDELAYED_HEAP_WAKE_TIME( pxTCB );
+        UBaseType_t uxParent;
+        UBaseType_t uxChild;
+
+        /* The wake times of stale entries do not change, as only
+         * prvAddCurrentTaskToDelayedList() sets them, so the heap order holds
+         * for them too.  Wake times are compared directly because all the tasks
+         * in one delayed list wake in the same tick count period. */
+        while( uxIndex > ( UBaseType_t ) 0U )
+        {
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) / ( UBaseType_t ) 2U;
+
+            if( taskDELAYED_HEAP_WAKE_TIME( pxHeap->pxTCBs[ uxParent ] ) <= xTimeToWake )
+            {
+                break;
+            }
+
+            pxHeap->pxTCBs[ uxIndex ] = pxHeap->pxTCBs[ uxParent ];
+            pxHeap->pxTCBs[ uxIndex ]->uxDelayedHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+            uxIndex = uxParent;
+        }
+
+        for( ; ; )
+        {
+            uxChild = ( uxIndex * ( UBaseType_t ) 2U ) + ( UBaseType_t ) 1U;
+
+            if( uxChild >= pxHeap->uxLength )
+            {
+                break;
+            }
+
+            if( ( ( uxChild + ( UBaseType_t ) 1U ) < pxHeap->uxLength ) &&
+                ( taskDELAYED_HEAP_WAKE_TIME( pxHeap->pxTCBs[ uxChild + ( UBaseType_t ) 1U ] ) < taskDELAYED_HEAP_WAKE_TIME( pxHeap->pxTCBs[ uxChild ] ) ) )
+            {
+                uxChild++;
+            }
+
+            if( taskDELAYED_HEAP_WAKE_TIME( pxHeap->pxTCBs[ uxChild ] ) >= xTimeToWake )
+            {
+                break;
+            }
+
+            pxHeap->pxTCBs[ uxIndex ] = pxHeap->pxTCBs[ uxChild ];
+            pxHeap->pxTCBs[ uxIndex ]->uxDelayedHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+            uxIndex = uxChild;
+        }
+
+        pxHeap->pxTCBs[ uxIndex ] = pxTCB;
+        pxTCB->uxDelayedHeapIndex = uxIndex + ( UBaseType_t ) 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedHeapInsert( DelayedTaskHeap_t * pxHeap,
+                                      TCB_t * pxTCB )
+    {
+        UBaseType_t uxIndex = pxTCB->uxDelayedHeapIndex;
+
+        if( ( uxIndex == ( UBaseType_t ) 0U ) ||
+            ( uxIndex > pxHeap->uxLength ) ||
+            ( pxHeap->pxTCBs[ uxIndex - ( UBaseType_t ) 1U ] != pxTCB ) )
+        {
+            /* No entry in this heap.  A stale one in the other heap goes. */
+            prvDelayedHeapRemove( pxTCB );
+
+            /* configDELAYED_TASK_HEAP_LENGTH must be at least the number of
+             * tasks. */
+            configASSERT( pxHeap->uxLength < ( UBaseType_t ) configDELAYED_TASK_HEAP_LENGTH );
+
+            pxHeap->pxTCBs[ pxHeap->uxLength ] = pxTCB;
+            pxHeap->uxLength++;
+            uxIndex = pxHeap->uxLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvDelayedHeapSift( pxHeap, uxIndex - ( UBaseType_t ) 1U );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDelayedHeapRemove( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxIndex = pxTCB->uxDelayedHeapIndex;
+        DelayedTaskHeap_t * pxHeap = &xDelayedTaskHeap1;
+        TCB_t * pxLastTCB;
+
+        if( uxIndex != ( UBaseType_t ) 0U )
+        {
+            if( ( uxIndex > pxHeap->uxLength ) ||
+                ( pxHeap->pxTCBs[ uxIndex - ( UBaseType_t ) 1U ] != pxTCB ) )
+            {
+                pxHeap = &xDelayedTaskHeap2;
+            }
+
+            configASSERT( pxHeap->pxTCBs[ uxIndex - ( UBaseType_t ) 1U ] == pxTCB );
+
+            pxTCB->uxDelayedHeapIndex = ( UBaseType_t ) 0U;
+            pxHeap->uxLength--;
+            pxLastTCB = pxHeap->pxTCBs[ pxHeap->uxLength ];
+
+            /* Fill the hole with the last entry. */
+            if( pxLastTCB != pxTCB )
+            {
+                pxHeap->pxTCBs[ uxIndex - ( UBaseType_t ) 1U ] = pxLastTCB;
+                prvDelayedHeapSift( pxHeap, uxIndex - ( UBaseType_t ) 1U );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDelayedHeapPeek( DelayedTaskHeap_t * pxHeap )
+    {
+        TCB_t * pxTCB = NULL;
+
+        while( pxHeap->uxLength > ( UBaseType_t ) 0U )
+        {
+            pxTCB = pxHeap->pxTCBs[ 0 ];
+
+            if( listIS_CONTAINED_WITHIN( pxHeap->pxList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                break;
+            }
+
+            /* The task left the Blocked state other than by the tick. */
+            prvDelayedHeapRemove( pxTCB );
+            pxTCB = NULL;
+        }
+
+        return pxTCB;
+    }
+
+#endif /* configUSE_DELAYED_TASK_HEAP */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -6831,6 +7201,55 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        /* A ceiling below the priority of a task that takes the mutex would let
+         * that task be preempted by other users of the mutex. */
+        configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+        /* Called from a critical section just after the calling task took the
+         * mutex, so the task is running and in its ready list. */
+        if( pxTCB->uxPriority < uxCeilingPriority )
+        {
+            /* Only reset the event list item value if the value is not being
+             * used for anything else. */
+            if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->uxPriority = uxCeilingPriority;
+            prvAddTaskToReadyList( pxTCB );
+
+            /* Traced as inheriting the ceiling. */
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
@@ -8630,14 +9049,14 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
                 traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-                vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxOverflowDelayedList, pxOverflowDelayedTaskHeap, pxCurrentTCB );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
                 traceMOVED_TASK_TO_DELAYED_LIST();
-                vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxDelayedList, pxDelayedTaskHeap, pxCurrentTCB );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -8667,13 +9086,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         {
             traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxOverflowDelayedList, pxOverflowDelayedTaskHeap, pxCurrentTCB );
         }
         else
         {
             traceMOVED_TASK_TO_DELAYED_LIST();
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxDelayedList, pxDelayedTaskHeap, pxCurrentTCB );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
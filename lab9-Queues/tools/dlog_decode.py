@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Decode the raw output of the deferred log service (sys_dlog) of lab 9.
+
+In SYS_DLOG_MODE_RAW the formatter task sends records instead of text:
+
+    0xA5, format ID (16 bit LE), argument count (8 bit), arguments (32 bit LE each)
+
+The format strings stay on the host.  They are read from the C source that
+declares the table (src/main.c by default): the enum gives the value of each
+LOG_ name and the table maps it to its format string.  Bytes that are not part
+of a frame, e.g. the text printed before the formatter task starts, are passed
+through unchanged, so a stream mixing text and frames reads naturally.
+
+Usage:
+    python3 dlog_decode.py capture.bin
+    python3 dlog_decode.py --port /dev/ttyACM0          (needs pyserial)
+    cat /dev/ttyACM0 | python3 dlog_decode.py -
+
+UART6 runs at 115200 baud, 8N1.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FRAME_SYNC = 0xA5
+FRAME_HEADER_SIZE = 4
+MAX_ARGS = 4
+
+DEFAULT_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "main.c")
+
+C_ESCAPES = {"n": "\n", "r": "\r", "t": "\t", "0": "\0", "\\": "\\", '"': '"', "'": "'"}
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d+))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXcsp%])")
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", " ", text)
+
+
+def c_string(literals):
+    """Joins adjacent C string literals and resolves their escapes."""
+    out = []
+    for literal in re.findall(r'"((?:[^"\\]|\\.)*)"', literals):
+        i = 0
+        while i < len(literal):
+            if literal[i] == "\\" and i + 1 < len(literal):
+                out.append(C_ESCAPES.get(literal[i + 1], literal[i + 1]))
+                i += 2
+            else:
+                out.append(literal[i])
+                i += 1
+    return "".join(out)
+
+
+def enum_values(text):
+    values = {}
+    for body in re.findall(r"\benum\b[^{;]*\{(.*?)\}", text, flags=re.S):
+        value = -1
+        for entry in body.split(","):
+            entry = entry.strip()
+            if not entry:
+                continue
+            name, _, expr = entry.partition("=")
+            name = name.strip()
+            if expr.strip():
+                value = int(expr.strip().rstrip("uU"), 0)
+            else:
+                value += 1
+            values[name] = value
+    return values
+
+
+def load_formats(path, table):
+    """Returns {format ID: format string} from the table declared in path."""
+    with open(path, encoding="utf-8", errors="replace") as source:
+        text = strip_comments(source.read())
+
+    match = re.search(r"\b" + re.escape(table) + r"\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;", text, flags=re.S)
+    if match is None:
+        raise SystemExit("no format table %s in %s" % (table, path))
+
+    values = enum_values(text)
+    formats = {}
+    index = 0
+    entries = re.findall(r'(?:\[\s*(\w+)\s*\]\s*=\s*)?((?:"(?:[^"\\]|\\.)*"\s*)+)', match.group(1))
+    for designator, literals in entries:
+        if designator:
+            index = values[designator] if designator in values else int(designator, 0)
+        formats[index] = c_string(literals)
+        index += 1
+    return formats
+
+
+def signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def render(fmt, args):
+    """printf with 32 bit arguments, as snprintf on the PIC32 would do it."""
+    pending = list(args)
+
+    def take():
+        return pending.pop(0) if pending else 0
+
+    def convert(match):
+        conv = match.group("conv")
+        if conv == "%":
+            return "%"
+        width = match.group("width")
+        prec = match.group("prec")
+        if width == "*":
+            width = str(signed(take()))
+        if prec == "*":
+            prec = str(signed(take()))
+        spec = "%" + match.group("flags") + (width or "") + ("." + prec if prec else "")
+        value = take()
+        if conv in "di":
+            return (spec + "d") % signed(value)
+        if conv == "u":
+            return (spec + "d") % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv in "sp":
+            # A pointer into the target, only its address made it here
+            return (spec + "s") % ("<0x%08X>" % value)
+        return (spec + conv) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, formats, show_ids):
+        self.formats = formats
+        self.show_ids = show_ids
+        self.pending = bytearray()
+
+    def frame_size(self, data):
+        """Size of the frame at the start of data, 0 if it needs more bytes,
+        None if data does not start with a frame."""
+        if data[0] != FRAME_SYNC:
+            return None
+        if len(data) < FRAME_HEADER_SIZE:
+            return 0
+        if data[3] > MAX_ARGS or (data[1] | (data[2] << 8)) not in self.formats:
+            return None
+        size = FRAME_HEADER_SIZE + 4 * data[3]
+        return size if len(data) >= size else 0
+
+    def feed(self, chunk, final=False):
+        self.pending += chunk
+        out = []
+        while self.pending:
+            size = self.frame_size(self.pending)
+            if size == 0 and not final:
+                break
+            if not size:
+                # Not a frame, pass the text through up to the next sync byte
+                end = self.pending.find(bytes([FRAME_SYNC]), 1)
+                end = len(self.pending) if end < 0 else end
+                out.append(self.pending[:end].decode("latin-1"))
+                del self.pending[:end]
+                continue
+            frame = self.pending[:size]
+            del self.pending[:size]
+            format_id = frame[1] | (frame[2] << 8)
+            args = [int.from_bytes(frame[i:i + 4], "little") for i in range(FRAME_HEADER_SIZE, size, 4)]
+            text = render(self.formats[format_id], args)
+            out.append(("[%u] " % format_id if self.show_ids else "") + text)
+        return "".join(out)
+
+
+def chunks_from_port(port, baud):
+    try:
+        import serial
+    except ImportError:
+        raise SystemExit("--port needs pyserial (pip install pyserial)")
+    with serial.Serial(port, baud, timeout=0.1) as uart:
+        while True:
+            data = uart.read(256)
+            if data:
+                yield data
+
+
+def chunks_from_file(path):
+    stream = sys.stdin.buffer if path == "-" else open(path, "rb")
+    with stream:
+        while True:
+            data = stream.read1(256) if hasattr(stream, "read1") else stream.read(256)
+            if not data:
+                return
+            yield data
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode raw sys_dlog frames into text.")
+    parser.add_argument("capture", nargs="?", help="captured stream, - for stdin")
+    parser.add_argument("--port", help="read a serial port instead of a capture")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--source", default=DEFAULT_SOURCE, help="C file declaring the format table")
+    parser.add_argument("--table", default="xLogFormats", help="name of the format table")
+    parser.add_argument("--ids", action="store_true", help="prefix each record with its format ID")
+    options = parser.parse_args()
+
+    if (options.capture is None) == (options.port is None):
+        parser.error("give a capture or --port")
+
+    decoder = Decoder(load_formats(options.source, options.table), options.ids)
+    chunks = chunks_from_port(options.port, options.baud) if options.port else chunks_from_file(options.capture)
+
+    try:
+        for chunk in chunks:
+            sys.stdout.write(decoder.feed(chunk))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    sys.stdout.write(decoder.feed(b"", final=True))
+
+
+if __name__ == "__main__":
+    main()